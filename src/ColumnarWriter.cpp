@@ -0,0 +1,340 @@
+#include "ColumnarWriter.h"
+#include <cstring>
+
+namespace {
+
+const char kMagic[8] = {'U', 'A', 'C', 'O', 'L', 'S', '0', '1'};
+
+void putVarint(std::string& out, std::uint64_t v) {
+    do {
+        auto byte = static_cast<char>(v & 0x7F);
+        v >>= 7;
+        if (v) byte = static_cast<char>(byte | 0x80);
+        out += byte;
+    } while (v);
+}
+
+void putU64(std::string& out, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) out += static_cast<char>((v >> (8 * i)) & 0xFF);
+}
+
+class Cursor {
+public:
+    Cursor(const char* data, std::size_t size) : m_data(data), m_size(size) {}
+
+    bool varint(std::uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (m_pos >= m_size) return false;
+            auto byte = static_cast<unsigned char>(m_data[m_pos++]);
+            v |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool u64(std::uint64_t& v) {
+        if (m_size - m_pos < 8) return false;
+        v = 0;
+        for (int i = 0; i < 8; ++i)
+            v |= static_cast<std::uint64_t>(static_cast<unsigned char>(m_data[m_pos++])) << (8 * i);
+        return true;
+    }
+
+    bool bytes(std::size_t n, std::string& out) {
+        if (m_size - m_pos < n) return false;
+        out.assign(m_data + m_pos, n);
+        m_pos += n;
+        return true;
+    }
+
+    bool byte(std::uint8_t& b) {
+        if (m_pos >= m_size) return false;
+        b = static_cast<std::uint8_t>(m_data[m_pos++]);
+        return true;
+    }
+
+private:
+    const char* m_data;
+    std::size_t m_size;
+    std::size_t m_pos{0};
+};
+
+bool readStrings(Cursor& c, std::size_t rows, ColumnarWriter::Encoding enc,
+                 std::vector<ExportRow>& out, std::string ExportRow::*field) {
+    if (enc == ColumnarWriter::Encoding::Plain) {
+        std::uint64_t len = 0;
+        for (std::size_t r = 0; r < rows; ++r) {
+            if (!c.varint(len) || !c.bytes(len, out[r].*field)) return false;
+        }
+        return true;
+    }
+    if (enc != ColumnarWriter::Encoding::Dictionary) return false;
+
+    std::uint64_t count = 0, len = 0, id = 0;
+    if (!c.varint(count) || count > rows) return false;
+    std::vector<std::string> dict(count);
+    for (auto& s : dict) {
+        if (!c.varint(len) || !c.bytes(len, s)) return false;
+    }
+    for (std::size_t r = 0; r < rows; ++r) {
+        if (!c.varint(id) || id >= dict.size()) return false;
+        out[r].*field = dict[id];
+    }
+    return true;
+}
+
+} // namespace
+
+// ------------------------------------------------------------ ColumnarWriter
+
+void ColumnarWriter::DictColumn::add(const std::string& s) {
+    auto it = index.find(s);
+    if (it == index.end()) {
+        it = index.emplace(s, static_cast<std::uint32_t>(values.size())).first;
+        values.push_back(it->first);
+    }
+    ids.push_back(it->second);
+}
+
+void ColumnarWriter::DictColumn::clear() {
+    index.clear();
+    values.clear();
+    ids.clear();
+}
+
+void ColumnarWriter::StringColumn::add(const std::string& s) {
+    data += s;
+    lengths.push_back(static_cast<std::uint32_t>(s.size()));
+}
+
+void ColumnarWriter::StringColumn::clear() {
+    data.clear();
+    lengths.clear();
+}
+
+ColumnarWriter::ColumnarWriter(std::size_t rowGroupSize)
+    : m_rowGroupSize(rowGroupSize == 0 ? kDefaultRowGroupSize : rowGroupSize) {}
+
+ColumnarWriter::~ColumnarWriter() {
+    close();
+}
+
+bool ColumnarWriter::open(const std::string& fileName) {
+    m_out.open(fileName, std::ios::binary | std::ios::trunc);
+    if (!m_out) return false;
+    m_out.write(kMagic, sizeof(kMagic));
+    m_rowsWritten = 0;
+    m_groups.clear();
+    return static_cast<bool>(m_out);
+}
+
+bool ColumnarWriter::append(const ExportRow& row) {
+    if (!m_out.is_open()) return false;
+
+    m_path.add(row.path);
+    m_nodeId.add(row.nodeId);
+    m_type.add(row.type);
+    m_text.add(row.text);
+    m_value.push_back(row.value);
+    m_timestamp.push_back(row.timestampMs);
+    m_good.push_back(row.good ? 1 : 0);
+
+    if (m_value.size() >= m_rowGroupSize) return flush();
+    return true;
+}
+
+bool ColumnarWriter::flush() {
+    const std::size_t rows = m_value.size();
+    if (rows == 0) return true;
+
+    std::uint64_t offset = static_cast<std::uint64_t>(m_out.tellp());
+    std::string header;
+    putVarint(header, rows);
+    m_out.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    auto writeColumn = [this](Encoding enc) {
+        std::string prefix(1, static_cast<char>(enc));
+        putU64(prefix, m_scratch.size());
+        m_out.write(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+        m_out.write(m_scratch.data(), static_cast<std::streamsize>(m_scratch.size()));
+        m_scratch.clear();
+    };
+    // A dictionary only pays off when values repeat, as paths do in history
+    // exports; in a snapshot every path is unique, so write those plain.
+    auto encodeDict = [this](const DictColumn& col) {
+        if (col.values.size() * 2 > col.ids.size()) {
+            for (auto id : col.ids) {
+                putVarint(m_scratch, col.values[id].size());
+                m_scratch.append(col.values[id].data(), col.values[id].size());
+            }
+            return Encoding::Plain;
+        }
+        putVarint(m_scratch, col.values.size());
+        for (auto v : col.values) {
+            putVarint(m_scratch, v.size());
+            m_scratch.append(v.data(), v.size());
+        }
+        for (auto id : col.ids) putVarint(m_scratch, id);
+        return Encoding::Dictionary;
+    };
+    auto encodePlain = [this](const StringColumn& col) {
+        std::size_t pos = 0;
+        for (auto len : col.lengths) {
+            putVarint(m_scratch, len);
+            m_scratch.append(col.data, pos, len);
+            pos += len;
+        }
+    };
+
+    writeColumn(encodeDict(m_path));
+    encodePlain(m_nodeId);
+    writeColumn(Encoding::Plain);
+    writeColumn(encodeDict(m_type));
+    encodePlain(m_text);
+    writeColumn(Encoding::Plain);
+
+    for (double v : m_value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        putU64(m_scratch, bits);
+    }
+    writeColumn(Encoding::Double);
+    for (auto t : m_timestamp) putU64(m_scratch, static_cast<std::uint64_t>(t));
+    writeColumn(Encoding::Int64);
+    m_scratch.append(reinterpret_cast<const char*>(m_good.data()), m_good.size());
+    writeColumn(Encoding::Bool);
+
+    m_groups.emplace_back(offset, rows);
+    m_rowsWritten += rows;
+
+    // clear() keeps capacity, so steady-state exports do not allocate.
+    m_path.clear();
+    m_nodeId.clear();
+    m_type.clear();
+    m_text.clear();
+    m_value.clear();
+    m_timestamp.clear();
+    m_good.clear();
+    return static_cast<bool>(m_out);
+}
+
+bool ColumnarWriter::close() {
+    if (!m_out.is_open()) return false;
+    bool ok = flush();
+
+    std::uint64_t footerOffset = static_cast<std::uint64_t>(m_out.tellp());
+    std::string footer;
+    putVarint(footer, m_groups.size());
+    for (const auto& [offset, rows] : m_groups) {
+        putU64(footer, offset);
+        putVarint(footer, rows);
+    }
+    putVarint(footer, m_rowsWritten);
+    putU64(footer, footerOffset);
+    footer.append(kMagic, sizeof(kMagic));
+    m_out.write(footer.data(), static_cast<std::streamsize>(footer.size()));
+
+    ok = ok && static_cast<bool>(m_out);
+    m_out.close();
+    return ok;
+}
+
+// ------------------------------------------------------------ ColumnarReader
+
+bool ColumnarReader::open(const std::string& fileName) {
+    m_in.open(fileName, std::ios::binary);
+    if (!m_in) return false;
+
+    m_in.seekg(0, std::ios::end);
+    auto size = static_cast<std::uint64_t>(m_in.tellg());
+    if (size < 2 * sizeof(kMagic) + 8) return false;
+
+    std::string tail(16, '\0');
+    m_in.seekg(static_cast<std::streamoff>(size - 16));
+    m_in.read(&tail[0], 16);
+    if (tail.compare(8, 8, kMagic, 8) != 0) return false;
+
+    std::uint64_t footerOffset = 0;
+    Cursor t(tail.data(), 8);
+    t.u64(footerOffset);
+    if (footerOffset >= size - 16) return false;
+
+    std::string footer(size - 16 - footerOffset, '\0');
+    m_in.seekg(static_cast<std::streamoff>(footerOffset));
+    m_in.read(&footer[0], static_cast<std::streamsize>(footer.size()));
+
+    Cursor c(footer.data(), footer.size());
+    std::uint64_t groups = 0;
+    if (!c.varint(groups) || groups > footer.size()) return false;
+    m_groups.resize(groups);
+    for (auto& [offset, rows] : m_groups) {
+        if (!c.u64(offset) || !c.varint(rows)) return false;
+    }
+    return c.varint(m_totalRows);
+}
+
+bool ColumnarReader::readRowGroup(std::size_t group, std::vector<ExportRow>& rows) {
+    if (group >= m_groups.size()) return false;
+    m_in.clear();
+    m_in.seekg(static_cast<std::streamoff>(m_groups[group].first));
+
+    // Row count varint is at most 10 bytes.
+    std::string head(10, '\0');
+    m_in.read(&head[0], 10);
+    m_in.clear();
+    Cursor h(head.data(), head.size());
+    std::uint64_t count = 0;
+    if (!h.varint(count) || count != m_groups[group].second) return false;
+
+    std::size_t headLen = 0;
+    for (std::uint64_t v = count; ; v >>= 7) { ++headLen; if (v < 0x80) break; }
+    m_in.seekg(static_cast<std::streamoff>(m_groups[group].first + headLen));
+
+    rows.assign(count, ExportRow{});
+    std::string chunk;
+    for (std::size_t col = 0; col < ColumnarWriter::kColumnCount; ++col) {
+        char prefix[9];
+        if (!m_in.read(prefix, 9)) return false;
+        Cursor p(prefix, 9);
+        std::uint8_t enc = 0;
+        std::uint64_t size = 0;
+        p.byte(enc);
+        p.u64(size);
+        chunk.resize(size);
+        if (size && !m_in.read(&chunk[0], static_cast<std::streamsize>(size))) return false;
+
+        Cursor c(chunk.data(), chunk.size());
+        auto encoding = static_cast<ColumnarWriter::Encoding>(enc);
+        bool ok = true;
+        switch (col) {
+        case 0: ok = readStrings(c, count, encoding, rows, &ExportRow::path); break;
+        case 1: ok = readStrings(c, count, encoding, rows, &ExportRow::nodeId); break;
+        case 2: ok = readStrings(c, count, encoding, rows, &ExportRow::type); break;
+        case 3: ok = readStrings(c, count, encoding, rows, &ExportRow::text); break;
+        case 4:
+            for (auto& r : rows) {
+                std::uint64_t bits = 0;
+                ok = ok && c.u64(bits);
+                std::memcpy(&r.value, &bits, sizeof(bits));
+            }
+            break;
+        case 5:
+            for (auto& r : rows) {
+                std::uint64_t bits = 0;
+                ok = ok && c.u64(bits);
+                r.timestampMs = static_cast<std::int64_t>(bits);
+            }
+            break;
+        case 6:
+            for (auto& r : rows) {
+                std::uint8_t b = 0;
+                ok = ok && c.byte(b);
+                r.good = b != 0;
+            }
+            break;
+        }
+        if (!ok) return false;
+    }
+    return true;
+}
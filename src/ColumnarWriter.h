@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// One exported sample. Snapshot exports use one row per node; history
+// exports repeat a path with different timestamps.
+struct ExportRow {
+    std::string path;
+    std::string nodeId;
+    std::string type;
+    std::string text;
+    double value{0.0};        // NaN when the value is not numeric
+    std::int64_t timestampMs{0};
+    bool good{true};
+};
+
+// Streams rows to a columnar file in fixed-size row groups, so memory use
+// depends on the row group size only.
+//
+// File layout (integers little-endian, "varint" is LEB128):
+//   "UACOLS01"
+//   row group*   varint rows, then per column: u8 encoding, u64 byte size, data
+//   footer       varint groups, per group u64 offset + varint rows,
+//                varint total rows
+//   u64 footer offset, "UACOLS01"
+//
+// Column order is path, node_id, type, text, value, timestamp_ms, good.
+// Encodings: Plain strings are varint length + bytes; Dictionary strings
+// store the distinct values of the group followed by a varint index per row.
+// Path and type use Dictionary when a group repeats its values (history
+// exports) and Plain otherwise (snapshots, where every path is unique);
+// Double and Int64 are raw 8-byte arrays; Bool is one byte per row.
+class ColumnarWriter {
+public:
+    enum class Encoding : std::uint8_t { Plain = 1, Dictionary, Double, Int64, Bool };
+
+    static constexpr std::size_t kDefaultRowGroupSize = 64 * 1024;
+    static constexpr std::size_t kColumnCount = 7;
+
+    explicit ColumnarWriter(std::size_t rowGroupSize = kDefaultRowGroupSize);
+    ~ColumnarWriter();
+
+    bool open(const std::string& fileName);
+    bool append(const ExportRow& row);
+    bool close();
+
+    std::uint64_t rowsWritten() const { return m_rowsWritten; }
+    std::size_t rowGroups() const { return m_groups.size(); }
+
+private:
+    struct DictColumn {
+        std::unordered_map<std::string, std::uint32_t> index;
+        std::vector<std::string_view> values;
+        std::vector<std::uint32_t> ids;
+        void add(const std::string& s);
+        void clear();
+    };
+    struct StringColumn {
+        std::string data;
+        std::vector<std::uint32_t> lengths;
+        void add(const std::string& s);
+        void clear();
+    };
+
+    bool flush();
+
+    std::size_t m_rowGroupSize;
+    std::ofstream m_out;
+    std::uint64_t m_rowsWritten{0};
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> m_groups;
+
+    DictColumn m_path;
+    StringColumn m_nodeId;
+    DictColumn m_type;
+    StringColumn m_text;
+    std::vector<double> m_value;
+    std::vector<std::int64_t> m_timestamp;
+    std::vector<std::uint8_t> m_good;
+    std::string m_scratch;
+};
+
+// Reads files produced by ColumnarWriter one row group at a time.
+class ColumnarReader {
+public:
+    bool open(const std::string& fileName);
+
+    std::size_t rowGroups() const { return m_groups.size(); }
+    std::uint64_t totalRows() const { return m_totalRows; }
+    bool readRowGroup(std::size_t group, std::vector<ExportRow>& rows);
+
+private:
+    std::ifstream m_in;
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> m_groups;
+    std::uint64_t m_totalRows{0};
+};
@@ -0,0 +1,101 @@
+#include "ExportJob.h"
+#include <chrono>
+#include <limits>
+
+ExportJob::~ExportJob() {
+    cancel();
+    wait();
+}
+
+bool ExportJob::start(OpcUaClient& client, const std::string& fileName,
+                      std::size_t rowGroupSize, ProgressCallback progress) {
+    if (isRunning()) return false;
+    wait();
+
+    m_cancel = false;
+    m_done = 0;
+    m_total = 0;
+    m_state = State::Running;
+    m_thread = std::thread(&ExportJob::run, this, std::ref(client), fileName,
+                           rowGroupSize, std::move(progress));
+    return true;
+}
+
+void ExportJob::cancel() {
+    m_cancel = true;
+}
+
+void ExportJob::wait() {
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void ExportJob::run(OpcUaClient& client, std::string fileName, std::size_t rowGroupSize,
+                    ProgressCallback progress) {
+    if (rowGroupSize == 0) rowGroupSize = ColumnarWriter::kDefaultRowGroupSize;
+    ColumnarWriter writer(rowGroupSize);
+    NodeRegistry registry;
+    if (!writer.open(fileName)) {
+        m_state = State::Failed;
+        return;
+    }
+    if (!client.browse_into(registry, &m_cancel)) {
+        writer.close();
+        m_state = m_cancel ? State::Cancelled : State::Failed;
+        return;
+    }
+
+    std::uint64_t total = 0;
+    for (auto id : registry.packedIds()) total += id != 0;
+    m_total = total;
+
+    ExportRow row;
+    std::uint64_t done = 0;
+    std::vector<NodeIndex> chunk;
+    std::vector<std::string> ids;
+    chunk.reserve(OpcUaClient::kReadChunk);
+    ids.reserve(OpcUaClient::kReadChunk);
+
+    for (NodeIndex next = 0; next < registry.size();) {
+        if (m_cancel) {
+            writer.close();
+            m_state = State::Cancelled;
+            return;
+        }
+
+        chunk.clear();
+        ids.clear();
+        for (; next < registry.size() && chunk.size() < OpcUaClient::kReadChunk; ++next) {
+            if (!registry.hasNodeId(next)) continue;
+            chunk.push_back(next);
+            ids.push_back(registry.nodeId(next));
+        }
+        if (chunk.empty()) break;
+
+        // A snapshot leaves the live filter state and subscribers alone.
+        std::vector<ReadResult> results = client.snapshot_values(ids);
+        const std::int64_t timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        for (std::size_t k = 0; k < chunk.size(); ++k) {
+            ReadResult& r = results[k];
+            row.nodeId = std::move(ids[k]);
+            row.path = registry.displayPath(chunk[k]);
+            row.timestampMs = timestampMs;
+            row.good = r.value != "<error>";
+            row.type = r.type;
+            if (!toNumber(r, row.value)) row.value = std::numeric_limits<double>::quiet_NaN();
+            row.text = std::move(r.value);
+
+            if (!writer.append(row)) {
+                m_state = State::Failed;
+                return;
+            }
+            m_done = ++done;
+            if (progress && done % rowGroupSize == 0) progress(done, total);
+        }
+    }
+
+    bool ok = writer.close();
+    if (progress) progress(done, total);
+    m_state = ok ? State::Finished : State::Failed;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include "ColumnarWriter.h"
+#include "OpcUaClient.h"
+
+// Background export of the browsed address space with current values to a
+// columnar file. The worker holds the client lock for one browse request or
+// one snapshot_values() chunk at a time, so interactive reads on the same
+// OpcUaClient interleave with the export instead of waiting for it.
+// The address space is browsed into a NodeRegistry before the first row is
+// written, so memory grows with the node count (roughly one node id, browse
+// name and parent link per node); only the rows are streamed.
+class ExportJob {
+public:
+    enum class State { Idle, Running, Finished, Failed, Cancelled };
+
+    // Called from the worker thread after every row group and at the end.
+    using ProgressCallback = std::function<void(std::uint64_t done, std::uint64_t total)>;
+
+    ExportJob() = default;
+    ~ExportJob();
+
+    ExportJob(const ExportJob&) = delete;
+    ExportJob& operator=(const ExportJob&) = delete;
+
+    bool start(OpcUaClient& client, const std::string& fileName,
+               std::size_t rowGroupSize = ColumnarWriter::kDefaultRowGroupSize,
+               ProgressCallback progress = {});
+    void cancel();
+    void wait();
+
+    State state() const { return m_state.load(); }
+    bool isRunning() const { return state() == State::Running; }
+    std::uint64_t rowsDone() const { return m_done.load(); }
+    std::uint64_t rowsTotal() const { return m_total.load(); }
+
+private:
+    void run(OpcUaClient& client, std::string fileName, std::size_t rowGroupSize,
+             ProgressCallback progress);
+
+    std::thread m_thread;
+    std::atomic<State> m_state{State::Idle};
+    std::atomic<bool> m_cancel{false};
+    std::atomic<std::uint64_t> m_done{0};
+    std::atomic<std::uint64_t> m_total{0};
+};
@@ -1,48 +1,252 @@
 #include "OpcUaClient.h"
 #include "ua/MockUaClient.h"
 #include "ua/Open62541Client.h"
+#include "ua/RecordingUaClient.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 class OpcUaClient::Impl {
 public:
-    std::unique_ptr<IUaClient> client;
+    // Shared so a browse running outside the call mutex keeps its backend
+    // alive if connect() or a capture swaps in another one meanwhile.
+    std::shared_ptr<IUaClient> client;
+    PathResolver resolver;
+    std::shared_ptr<CaptureWriter> capture;
+    ValueBus bus;
+    ValueFilter filter;
+
+    static std::int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    // Serializes backend calls so a background job (e.g. an export) can share
+    // the connection with the GUI; held for one service request at a time
+    // (read_values() sends one Read request per chunk).
+    std::mutex mutex;
+    // Held for a whole resolve_paths() while the call mutex is taken per
+    // request; taken before the call mutex wherever the client is swapped,
+    // so the resolver never sees its client change mid-resolve.
+    std::mutex resolverMutex;
+
+    void setClient(std::shared_ptr<IUaClient> c) {
+        client = std::move(c);
+        resolver.setClient(client.get());
+    }
+
+    // Updates that passed the filter, queued under the call mutex so they
+    // keep read order, and published to the bus after it is released. The
+    // queue holds about kMaxPending updates; readers wait for room before
+    // taking the call mutex, so a stalled publisher slows reads down without
+    // blocking writes, browses or other calls.
+    static constexpr std::size_t kMaxPending = ValueBus::kDefaultCapacity;
+    std::mutex pendingMutex;
+    std::condition_variable pendingRoom;
+    std::vector<ValueUpdate> pending;
+    std::mutex publishMutex;
+
+    void waitForRoom() {
+        std::unique_lock<std::mutex> lock(pendingMutex);
+        pendingRoom.wait(lock, [this] { return pending.size() < kMaxPending; });
+    }
+
+    void enqueue(std::vector<ValueUpdate>& updates, const std::vector<std::uint8_t>& pass) {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        for (std::size_t i = 0; i < updates.size(); ++i) {
+            if (pass[i]) pending.push_back(std::move(updates[i]));
+        }
+    }
+
+    // One thread publishes at a time and takes over whatever others queued
+    // meanwhile; a thread that finds the publisher busy returns at once.
+    void drain() {
+        std::vector<ValueUpdate> batch;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> publishing(publishMutex, std::try_to_lock);
+                if (!publishing) return;
+                {
+                    std::lock_guard<std::mutex> lock(pendingMutex);
+                    batch.swap(pending);
+                }
+                pendingRoom.notify_all();
+                for (const auto& u : batch) bus.publish(u);
+                batch.clear();
+            }
+            // Anything queued while we were publishing was left to us.
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            if (pending.empty()) return;
+        }
+    }
+
+    // Live reads go through the filter to the bus; snapshots skip both.
+    std::vector<ReadResult> read(const std::vector<std::string>& nodeIds, bool live) {
+        std::vector<ReadResult> results;
+        std::vector<ValueUpdate> updates;
+        std::vector<std::uint8_t> pass;
+        results.reserve(nodeIds.size());
+
+        for (std::size_t start = 0; start < nodeIds.size(); start += kReadChunk) {
+            const std::size_t end = std::min(nodeIds.size(), start + kReadChunk);
+            if (live && bus.hasSubscribers()) waitForRoom();
+            {
+                // Reads, filter decisions and queueing of one chunk share the
+                // lock, so updates reach the filter and the bus in read order.
+                std::lock_guard<std::mutex> lock(mutex);
+                const std::vector<std::string> chunk(nodeIds.begin() + start, nodeIds.begin() + end);
+                std::vector<ReadResult> values = client
+                    ? client->readValues(chunk)
+                    : std::vector<ReadResult>(chunk.size(), ReadResult{"<error>", "-"});
+                values.resize(chunk.size(), ReadResult{"<error>", "-"});
+                const bool publish = live && bus.hasSubscribers();
+                const std::int64_t now = nowMs();
+                for (std::size_t i = 0; i < chunk.size(); ++i) {
+                    if (publish) updates.push_back(ValueUpdate::fromRead(chunk[i], values[i], now));
+                    results.push_back(std::move(values[i]));
+                }
+                if (!updates.empty()) {
+                    pass.resize(updates.size());
+                    filter.filter(updates.data(), updates.size(), pass.data());
+                    enqueue(updates, pass);
+                    updates.clear();
+                }
+            }
+            drain();
+        }
+        return results;
+    }
 };
 
 OpcUaClient::OpcUaClient() : m_impl(std::make_unique<Impl>()) {}
 OpcUaClient::~OpcUaClient() = default;
 
 bool OpcUaClient::connect(const std::string& url) {
-    auto real = std::make_unique<Open62541Client>();
+    std::scoped_lock lock(m_impl->resolverMutex, m_impl->mutex);
+    std::unique_ptr<IUaClient> real = std::make_unique<Open62541Client>();
+    if (m_impl->capture)
+        real = std::make_unique<RecordingUaClient>(std::move(real), m_impl->capture);
     if (real->connect(url)) {
-        m_impl->client = std::move(real);
+        m_impl->setClient(std::move(real));
         return true;
     }
 
     auto mock = std::make_unique<MockUaClient>();
     bool ok = mock->connect(url);
-    m_impl->client = std::move(mock);
+    m_impl->setClient(std::move(mock));
     return ok;
 }
 
 void OpcUaClient::disconnect() {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
     if (m_impl->client)
         m_impl->client->disconnect();
 }
 
 bool OpcUaClient::isConnected() const {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
     return m_impl->client && m_impl->client->isConnected();
 }
 
 std::vector<BrowseItem> OpcUaClient::browse_objects() {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
     if (!m_impl->client) return {};
     return m_impl->client->browseObjects();
 }
 
+bool OpcUaClient::browse_into(NodeRegistry& registry, const std::atomic<bool>* cancel) {
+    std::shared_ptr<IUaClient> client;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        client = m_impl->client;
+    }
+    if (!client) return false;
+
+    // Lock per Browse/BrowseNext request so a long crawl does not block
+    // reads from other threads.
+    bool cancelled = false;
+    client->browseInto(registry, [&](const std::function<void()>& request) {
+        if (cancel && cancel->load()) {
+            cancelled = true;
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        request();
+        return true;
+    });
+    return !cancelled;
+}
+
+std::vector<std::string> OpcUaClient::resolve_paths(const std::vector<std::string>& displayPaths) {
+    std::lock_guard<std::mutex> resolving(m_impl->resolverMutex);
+    return m_impl->resolver.resolve(displayPaths, [&](const std::function<void()>& request) {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        request();
+        return true;
+    });
+}
+
+PathResolver& OpcUaClient::path_resolver() {
+    return m_impl->resolver;
+}
+
+bool OpcUaClient::start_capture(const std::string& fileName) {
+    std::scoped_lock lock(m_impl->resolverMutex, m_impl->mutex);
+    auto writer = std::make_shared<CaptureWriter>();
+    if (!writer->open(fileName)) return false;
+    if (m_impl->capture) m_impl->capture->close();
+    m_impl->capture = writer;
+
+    // A capture already running hands its session over to the new log.
+    if (auto* rec = dynamic_cast<RecordingUaClient*>(m_impl->client.get()))
+        m_impl->setClient(rec->inner());
+    if (dynamic_cast<Open62541Client*>(m_impl->client.get()))
+        m_impl->setClient(std::make_shared<RecordingUaClient>(m_impl->client, writer));
+    return true;
+}
+
+void OpcUaClient::stop_capture() {
+    std::scoped_lock lock(m_impl->resolverMutex, m_impl->mutex);
+    if (!m_impl->capture) return;
+    m_impl->capture->close();
+    m_impl->capture.reset();
+
+    // Unwrap so later calls skip record building and a new capture can wrap
+    // the backend again.
+    if (auto* rec = dynamic_cast<RecordingUaClient*>(m_impl->client.get()))
+        m_impl->setClient(rec->inner());
+}
+
+bool OpcUaClient::open_replay(const std::string& fileName, ReplayPacing pacing) {
+    std::scoped_lock lock(m_impl->resolverMutex, m_impl->mutex);
+    auto replay = ReplayUaClient::open(fileName, pacing);
+    if (!replay || !replay->connect(fileName)) return false;
+    m_impl->setClient(std::move(replay));
+    return true;
+}
+
 ReadResult OpcUaClient::read_value(const std::string& nodeId) {
-    if (!m_impl->client) return {"<error>", "-"};
-    return m_impl->client->readValue(nodeId);
+    return read_values({nodeId}).front();
+}
+
+std::vector<ReadResult> OpcUaClient::read_values(const std::vector<std::string>& nodeIds) {
+    return m_impl->read(nodeIds, true);
+}
+
+std::vector<ReadResult> OpcUaClient::snapshot_values(const std::vector<std::string>& nodeIds) {
+    return m_impl->read(nodeIds, false);
+}
+
+ValueBus& OpcUaClient::value_bus() {
+    return m_impl->bus;
+}
+
+ValueFilter& OpcUaClient::value_filter() {
+    return m_impl->filter;
 }
 
 bool OpcUaClient::write_value(const std::string& nodeId, const std::string& value) {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
     if (!m_impl->client) return false;
     return m_impl->client->writeValue(nodeId, value);
 }
@@ -1,12 +1,20 @@
 #pragma once
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <string>
 #include "IUaClient.h"  
 #include "UaTypes.h"    
+#include "PathResolver.h"
+#include "ReplayUaClient.h"
+#include "ValueBus.h"
+#include "ValueFilter.h"
 
 class OpcUaClient {
 public:
+    // Nodes read_values() reads per Read request and hold of the call lock.
+    static constexpr std::size_t kReadChunk = 64;
+
     OpcUaClient();
     ~OpcUaClient();
 
@@ -15,7 +23,38 @@ public:
     bool isConnected() const;
 
     std::vector<BrowseItem> browse_objects();
+    // Takes the call lock per server request, so reads from other threads
+    // interleave with a long crawl. Returns false if cancel was set.
+    bool browse_into(NodeRegistry& registry, const std::atomic<bool>* cancel = nullptr);
+    // Like browse_into(), takes the call lock per server request.
+    std::vector<std::string> resolve_paths(const std::vector<std::string>& displayPaths);
+    // Direct access for cache load/save; not synchronized with other calls.
+    PathResolver& path_resolver();
+
+    // Records all traffic of the real OPC UA backend to fileName, starting
+    // with the current session if there is one.
+    bool start_capture(const std::string& fileName);
+    void stop_capture();
+    // Replaces the backend with a replay of a capture log.
+    bool open_replay(const std::string& fileName,
+                     ReplayPacing pacing = ReplayPacing::AsFastAsPossible);
+
+    // Every read that passes value_filter() is published here; consumers
+    // subscribe instead of opening their own connection. Updates are
+    // published in read order after the call lock is released, by whichever
+    // reading thread gets there first; that may be the GUI thread. A full
+    // Backpressure subscriber blocks that thread and delays delivery to all
+    // subscribers; once the queue behind it is full, readers wait as well.
+    ValueBus& value_bus();
+    ValueFilter& value_filter();
+
     ReadResult read_value(const std::string& nodeId);
+    // Reads in chunks of kReadChunk; each chunk is filtered as one batch
+    // under the same lock as its reads, then published.
+    std::vector<ReadResult> read_values(const std::vector<std::string>& nodeIds);
+    // Same reads, but bypassing value_filter() and value_bus(): for bulk
+    // reads such as exports that must not touch live tag state.
+    std::vector<ReadResult> snapshot_values(const std::vector<std::string>& nodeIds);
     bool write_value(const std::string& nodeId, const std::string& value);
 
 private:
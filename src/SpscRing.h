@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Bounded lock-free single-producer/single-consumer queue. Capacity is
+// rounded up to a power of two; head and tail sit on separate cache lines so
+// producer and consumer do not contend.
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(std::size_t capacity) {
+        std::size_t n = 2;
+        while (n < capacity) n <<= 1;
+        m_slots.resize(n);
+        m_mask = n - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    std::size_t capacity() const { return m_slots.size(); }
+
+    std::size_t size() const {
+        // Head first: reading tail first lets a pop in between make head
+        // overtake it, and the difference wraps around.
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        const std::size_t tail = m_tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    bool tryPush(const T& value) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == m_slots.size()) return false;
+        m_slots[tail & m_mask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& out) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return false;
+        out = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::vector<T> m_slots;
+    std::size_t m_mask{0};
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+};
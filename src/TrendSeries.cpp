@@ -0,0 +1,267 @@
+#include "TrendSeries.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+// Raw ranges up to this many samples per pixel go through LTTB; larger ones
+// are served from the min/max pyramid.
+constexpr std::size_t kLttbSamplesPerPixel = 16;
+
+} // namespace
+
+std::vector<TrendPoint> lttb(const std::vector<TrendPoint>& points, std::size_t threshold) {
+    const std::size_t n = points.size();
+    if (threshold >= n || threshold < 3) return points;
+
+    std::vector<TrendPoint> out;
+    out.reserve(threshold);
+    out.push_back(points.front());
+
+    const std::int64_t t0 = points.front().timestampMs;
+    auto x = [&](std::size_t i) { return static_cast<double>(points[i].timestampMs - t0); };
+
+    const double every = static_cast<double>(n - 2) / static_cast<double>(threshold - 2);
+    std::size_t a = 0;
+    for (std::size_t i = 0; i < threshold - 2; ++i) {
+        // Average of the next bucket is the third triangle vertex.
+        auto avgStart = static_cast<std::size_t>(std::floor((i + 1) * every)) + 1;
+        auto avgEnd = std::min(static_cast<std::size_t>(std::floor((i + 2) * every)) + 1, n);
+        double avgX = 0.0, avgY = 0.0;
+        for (std::size_t j = avgStart; j < avgEnd; ++j) {
+            avgX += x(j);
+            avgY += points[j].value;
+        }
+        const double count = static_cast<double>(std::max<std::size_t>(avgEnd - avgStart, 1));
+        avgX /= count;
+        avgY /= count;
+
+        auto from = static_cast<std::size_t>(std::floor(i * every)) + 1;
+        auto to = static_cast<std::size_t>(std::floor((i + 1) * every)) + 1;
+        const double ax = x(a), ay = points[a].value;
+        double maxArea = -1.0;
+        std::size_t next = from;
+        for (std::size_t j = from; j < to; ++j) {
+            double area = std::abs((ax - avgX) * (points[j].value - ay) -
+                                   (ax - x(j)) * (avgY - ay));
+            if (area > maxArea) {
+                maxArea = area;
+                next = j;
+            }
+        }
+        out.push_back(points[next]);
+        a = next;
+    }
+
+    out.push_back(points.back());
+    return out;
+}
+
+void TrendSeries::append(std::int64_t timestampMs, double value) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const std::size_t n = m_size;
+    if (n > 0) timestampMs = std::max(timestampMs, timeAt(n - 1));
+    if (n % kChunkSize == 0) {
+        m_times.emplace_back();
+        m_values.emplace_back();
+    }
+    auto& times = m_times.back();
+    auto& values = m_values.back();
+    if (times.size() == times.capacity()) {
+        const std::size_t cap = std::min(kChunkSize, std::max(kFirstChunk, 2 * times.capacity()));
+        times.reserve(cap);
+        values.reserve(cap);
+    }
+    times.push_back(timestampMs);
+    values.push_back(value);
+    m_size = n + 1;
+
+    std::size_t span = kLeafSize;
+    for (std::size_t level = 0; ; ++level, span *= kFanout) {
+        if (level > 0 && level == m_levels.size()) {
+            // First sample beyond one bucket of the level below: build the
+            // new level from it (the current sample is already included).
+            std::vector<Bucket> built;
+            for (std::size_t j = 0; j < m_levels[level - 1].size(); ++j) {
+                const Bucket& src = m_levels[level - 1][j];
+                if (j % kFanout == 0) {
+                    built.push_back(src);
+                    continue;
+                }
+                Bucket& dst = built.back();
+                if (src.min < dst.min) { dst.min = src.min; dst.minTime = src.minTime; }
+                if (src.max > dst.max) { dst.max = src.max; dst.maxTime = src.maxTime; }
+            }
+            m_levels.push_back(std::move(built));
+        } else {
+            if (level == m_levels.size()) m_levels.emplace_back();
+            auto& buckets = m_levels[level];
+            const std::size_t b = n / span;
+            if (b == buckets.size()) {
+                buckets.push_back({value, value, timestampMs, timestampMs});
+            } else {
+                Bucket& bk = buckets[b];
+                if (value < bk.min) { bk.min = value; bk.minTime = timestampMs; }
+                if (value > bk.max) { bk.max = value; bk.maxTime = timestampMs; }
+            }
+        }
+        if (n < span) break;
+    }
+
+    m_version.fetch_add(1, std::memory_order_release);
+}
+
+std::size_t TrendSeries::lowerBound(std::int64_t t) const {
+    std::size_t lo = 0, hi = m_size;
+    while (lo < hi) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        if (timeAt(mid) < t) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+std::size_t TrendSeries::upperBound(std::int64_t t) const {
+    std::size_t lo = 0, hi = m_size;
+    while (lo < hi) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        if (timeAt(mid) <= t) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+std::vector<TrendPoint> TrendSeries::query(std::int64_t fromMs, std::int64_t toMs,
+                                           std::size_t pixels) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<TrendPoint> out;
+    if (m_size == 0 || pixels == 0 || toMs < fromMs) return out;
+
+    // One neighbour on each side so the line runs to the view edges.
+    std::size_t i0 = lowerBound(fromMs);
+    std::size_t i1 = upperBound(toMs);
+    if (i0 > 0) --i0;
+    if (i1 < m_size) ++i1;
+    const std::size_t n = i1 - i0;
+
+    if (n <= kLttbSamplesPerPixel * pixels) {
+        out.reserve(n);
+        for (std::size_t i = i0; i < i1; ++i) out.push_back({timeAt(i), valueAt(i)});
+        return n > 2 * pixels ? lttb(out, 2 * pixels) : out;
+    }
+
+    // Finest level with at most 8 buckets per pixel column.
+    std::size_t level = 0, span = kLeafSize;
+    while (level + 1 < m_levels.size() && n / span > 8 * pixels) {
+        ++level;
+        span *= kFanout;
+    }
+
+    struct Column {
+        bool used{false};
+        Bucket agg{};
+    };
+    std::vector<Column> cols(pixels);
+    const double width = std::max(1.0, static_cast<double>(toMs - fromMs) / static_cast<double>(pixels));
+    auto columnOf = [&](std::int64_t t) {
+        double c = static_cast<double>(t - fromMs) / width;
+        return static_cast<std::size_t>(std::clamp(c, 0.0, static_cast<double>(pixels - 1)));
+    };
+    auto addPoint = [&](std::int64_t t, double v) {
+        Column& c = cols[columnOf(t)];
+        if (!c.used) {
+            c.used = true;
+            c.agg = {v, v, t, t};
+            return;
+        }
+        if (v < c.agg.min) { c.agg.min = v; c.agg.minTime = t; }
+        if (v > c.agg.max) { c.agg.max = v; c.agg.maxTime = t; }
+    };
+
+    // Whole buckets contribute their extremes; buckets cut by the range
+    // edges are split into their children, down to raw samples at level 0.
+    auto collect = [&](auto& self, std::size_t lvl, std::size_t b, std::size_t bSpan) -> void {
+        const std::size_t first = b * bSpan;
+        const std::size_t last = std::min(first + bSpan, m_size);
+        if (first >= i1 || last <= i0) return;
+        if (first >= i0 && last <= i1) {
+            const Bucket& bk = m_levels[lvl][b];
+            addPoint(bk.minTime, bk.min);
+            addPoint(bk.maxTime, bk.max);
+            return;
+        }
+        if (lvl == 0) {
+            for (std::size_t i = std::max(first, i0); i < std::min(last, i1); ++i)
+                addPoint(timeAt(i), valueAt(i));
+            return;
+        }
+        const std::size_t childSpan = bSpan / kFanout;
+        for (std::size_t k = 0; k < kFanout; ++k)
+            self(self, lvl - 1, b * kFanout + k, childSpan);
+    };
+    for (std::size_t b = i0 / span; b <= (i1 - 1) / span; ++b)
+        collect(collect, level, b, span);
+
+    out.reserve(2 * pixels);
+    for (const Column& c : cols) {
+        if (!c.used) continue;
+        const Bucket& a = c.agg;
+        if (a.minTime == a.maxTime && a.min == a.max) {
+            out.push_back({a.minTime, a.min});
+        } else if (a.minTime <= a.maxTime) {
+            out.push_back({a.minTime, a.min});
+            out.push_back({a.maxTime, a.max});
+        } else {
+            out.push_back({a.maxTime, a.max});
+            out.push_back({a.minTime, a.min});
+        }
+    }
+    return out;
+}
+
+std::size_t TrendSeries::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+bool TrendSeries::timeRange(std::int64_t& firstMs, std::int64_t& lastMs) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_size == 0) return false;
+    firstMs = timeAt(0);
+    lastMs = timeAt(m_size - 1);
+    return true;
+}
+
+void TrendHistory::append(const ValueUpdate& update) {
+    if (!update.good) return;
+
+    double value = update.value;
+    if (!update.numeric) {
+        // Servers (and the mock) sometimes report numbers as String.
+        char* end = nullptr;
+        value = std::strtod(update.text.c_str(), &end);
+        if (update.text.empty() || !end || *end != '\0') return;
+    }
+    if (auto s = find(update.nodeId)) s->append(update.timestampMs, value);
+}
+
+std::shared_ptr<TrendSeries> TrendHistory::series(const std::string& nodeId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& s = m_series[nodeId];
+    if (!s) s = std::make_shared<TrendSeries>();
+    return s;
+}
+
+std::shared_ptr<TrendSeries> TrendHistory::find(const std::string& nodeId) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_series.find(nodeId);
+    return it != m_series.end() ? it->second : nullptr;
+}
+
+std::vector<std::string> TrendHistory::nodeIds() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::string> ids;
+    ids.reserve(m_series.size());
+    for (const auto& [nodeId, s] : m_series) ids.push_back(nodeId);
+    return ids;
+}
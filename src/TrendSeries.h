@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ValueBus.h"
+
+struct TrendPoint {
+    std::int64_t timestampMs;
+    double value;
+};
+
+// Largest-Triangle-Three-Buckets downsampling to at most `threshold` points.
+std::vector<TrendPoint> lttb(const std::vector<TrendPoint>& points, std::size_t threshold);
+
+// Append-only time series with a min/max pyramid maintained on append.
+// Level 0 summarizes kLeafSize samples, each further level kFanout buckets
+// of the level below, so query() touches O(pixels) buckets no matter how
+// many samples fall into the range. Timestamps are kept non-decreasing.
+// Samples live in chunks of kChunkSize; only the newest chunk grows, from
+// kFirstChunk up, so idle tags stay cheap and an append never copies more
+// than one chunk while holding the lock.
+class TrendSeries {
+public:
+    static constexpr std::size_t kFirstChunk = 256;
+    static constexpr std::size_t kChunkSize = 64 * 1024;
+    static constexpr std::size_t kLeafSize = 64;
+    static constexpr std::size_t kFanout = 8;
+
+    void append(std::int64_t timestampMs, double value);
+
+    // Points to draw [fromMs, toMs] at the given horizontal resolution: raw
+    // samples when few enough, otherwise per-column min/max in time order.
+    std::vector<TrendPoint> query(std::int64_t fromMs, std::int64_t toMs,
+                                  std::size_t pixels) const;
+
+    std::size_t size() const;
+    bool timeRange(std::int64_t& firstMs, std::int64_t& lastMs) const;
+    // Bumped on every append; lets views skip repaints when nothing changed.
+    std::uint64_t version() const { return m_version.load(std::memory_order_acquire); }
+
+private:
+    struct Bucket {
+        double min;
+        double max;
+        std::int64_t minTime;
+        std::int64_t maxTime;
+    };
+
+    std::int64_t timeAt(std::size_t i) const { return m_times[i / kChunkSize][i % kChunkSize]; }
+    double valueAt(std::size_t i) const { return m_values[i / kChunkSize][i % kChunkSize]; }
+    std::size_t lowerBound(std::int64_t t) const;
+    std::size_t upperBound(std::int64_t t) const;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::vector<std::int64_t>> m_times;
+    std::vector<std::vector<double>> m_values;
+    std::size_t m_size{0};
+    std::vector<std::vector<Bucket>> m_levels;
+    std::atomic<std::uint64_t> m_version{0};
+};
+
+// Per-tag trend history fed from a ValueBus subscription. Only tags asked
+// for through series() are recorded; updates for other tags are ignored.
+class TrendHistory {
+public:
+    void append(const ValueUpdate& update);
+    // Starts recording the tag if it is not recorded yet.
+    std::shared_ptr<TrendSeries> series(const std::string& nodeId);
+    // Null for tags that are not recorded.
+    std::shared_ptr<TrendSeries> find(const std::string& nodeId) const;
+    // Recorded tags, e.g. for the TopicFilter of the feeding subscription.
+    std::vector<std::string> nodeIds() const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, std::shared_ptr<TrendSeries>> m_series;
+};
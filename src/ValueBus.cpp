@@ -0,0 +1,103 @@
+#include "ValueBus.h"
+#include <algorithm>
+#include <chrono>
+
+ValueUpdate ValueUpdate::fromRead(const std::string& nodeId, const ReadResult& r,
+                                  std::int64_t timestampMs) {
+    ValueUpdate u;
+    u.nodeId = nodeId;
+    u.text = r.value;
+    u.type = r.type;
+    u.numeric = toNumber(r, u.value);
+    u.good = r.value != "<error>";
+    u.timestampMs = timestampMs;
+    return u;
+}
+
+bool TopicFilter::matches(const std::string& nodeId) const {
+    if (nodeIds.empty() && prefixes.empty()) return true;
+    if (nodeIds.count(nodeId)) return true;
+    for (const auto& p : prefixes) {
+        if (nodeId.compare(0, p.size(), p) == 0) return true;
+    }
+    return false;
+}
+
+ValueBus::Subscription::Subscription(TopicFilter filter, SlowConsumerPolicy policy,
+                                     std::size_t capacity)
+    : m_filter(std::move(filter)), m_policy(policy), m_ring(capacity) {}
+
+ValueBus::ValueBus() : m_subscribers(std::make_shared<const List>()) {}
+
+ValueBus::SubscriptionPtr ValueBus::subscribe(TopicFilter filter, SlowConsumerPolicy policy,
+                                              std::size_t capacity) {
+    auto sub = std::make_shared<Subscription>(std::move(filter), policy,
+                                              capacity == 0 ? kDefaultCapacity : capacity);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto next = std::make_shared<List>(*std::atomic_load(&m_subscribers));
+    next->push_back(sub);
+    m_count.store(next->size(), std::memory_order_release);
+    std::atomic_store(&m_subscribers, std::shared_ptr<const List>(std::move(next)));
+    return sub;
+}
+
+void ValueBus::unsubscribe(const SubscriptionPtr& subscription) {
+    if (!subscription) return;
+    // Releases a publisher blocked on this subscription under Backpressure.
+    subscription->m_active.store(false, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto next = std::make_shared<List>(*std::atomic_load(&m_subscribers));
+    next->erase(std::remove(next->begin(), next->end(), subscription), next->end());
+    m_count.store(next->size(), std::memory_order_release);
+    std::atomic_store(&m_subscribers, std::shared_ptr<const List>(std::move(next)));
+}
+
+void ValueBus::publish(const ValueUpdate& update) {
+    m_published.fetch_add(1, std::memory_order_relaxed);
+
+    // Lock-free snapshot; subscribe/unsubscribe swap in a new list.
+    auto subscribers = std::atomic_load(&m_subscribers);
+    for (const auto& sub : *subscribers) {
+        if (!sub->m_filter.matches(update.nodeId)) continue;
+
+        bool pushed = sub->m_ring.tryPush(update);
+        if (!pushed && sub->m_policy == SlowConsumerPolicy::Backpressure) {
+            // Spin briefly, then back off so a stalled consumer does not
+            // keep a core busy.
+            std::chrono::microseconds pause(10);
+            for (int spins = 0; !(pushed = sub->m_ring.tryPush(update)) && sub->isActive(); ++spins) {
+                if (spins < 16) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::this_thread::sleep_for(pause);
+                pause = std::min(pause * 2, std::chrono::microseconds(1000));
+            }
+        }
+
+        if (pushed)
+            sub->m_delivered.fetch_add(1, std::memory_order_relaxed);
+        else
+            sub->m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+CallbackConsumer::CallbackConsumer(ValueBus& bus, Callback callback, TopicFilter filter,
+                                   SlowConsumerPolicy policy, std::size_t capacity)
+    : m_bus(bus), m_subscription(bus.subscribe(std::move(filter), policy, capacity)) {
+    m_thread = std::thread([this, cb = std::move(callback)]() {
+        while (!m_stop.load(std::memory_order_acquire)) {
+            if (m_subscription->drain(cb) == 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        m_subscription->drain(cb);
+    });
+}
+
+CallbackConsumer::~CallbackConsumer() {
+    m_bus.unsubscribe(m_subscription);
+    m_stop.store(true, std::memory_order_release);
+    m_thread.join();
+}
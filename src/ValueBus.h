@@ -0,0 +1,131 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "SpscRing.h"
+#include "UaTypes.h"
+
+struct ValueUpdate {
+    std::string nodeId;
+    std::string text;
+    std::string type;
+    double value{0.0};
+    bool numeric{false};
+    bool good{true};
+    std::int64_t timestampMs{0};
+
+    static ValueUpdate fromRead(const std::string& nodeId, const ReadResult& r,
+                                std::int64_t timestampMs);
+};
+
+// Empty filter matches everything. Otherwise an update passes when its NodeId
+// is listed or starts with one of the prefixes (e.g. "ns=3;").
+struct TopicFilter {
+    std::unordered_set<std::string> nodeIds;
+    std::vector<std::string> prefixes;
+
+    bool matches(const std::string& nodeId) const;
+};
+
+enum class SlowConsumerPolicy {
+    Drop,          // a full queue loses the new update; counted in dropped()
+    Backpressure   // the publisher waits until the consumer makes room,
+                   // holding up delivery to every other subscriber too
+};
+
+// In-process fan-out of value updates from one client to many consumers.
+// A single producer publishes; each subscription owns a lock-free SPSC ring,
+// so consumers never block the producer or each other (except under the
+// Backpressure policy) and the server sees one connection regardless of the
+// number of consumers.
+class ValueBus {
+public:
+    static constexpr std::size_t kDefaultCapacity = 4096;
+
+    class Subscription {
+    public:
+        Subscription(TopicFilter filter, SlowConsumerPolicy policy, std::size_t capacity);
+
+        bool tryPop(ValueUpdate& out) { return m_ring.tryPop(out); }
+
+        template <typename F>
+        std::size_t drain(F&& fn, std::size_t maxItems = static_cast<std::size_t>(-1)) {
+            std::size_t n = 0;
+            ValueUpdate u;
+            while (n < maxItems && m_ring.tryPop(u)) {
+                fn(u);
+                ++n;
+            }
+            return n;
+        }
+
+        std::size_t pending() const { return m_ring.size(); }
+        std::uint64_t delivered() const { return m_delivered.load(std::memory_order_relaxed); }
+        std::uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+        bool isActive() const { return m_active.load(std::memory_order_acquire); }
+
+    private:
+        friend class ValueBus;
+
+        TopicFilter m_filter;
+        SlowConsumerPolicy m_policy;
+        SpscRing<ValueUpdate> m_ring;
+        std::atomic<std::uint64_t> m_delivered{0};
+        std::atomic<std::uint64_t> m_dropped{0};
+        std::atomic<bool> m_active{true};
+    };
+
+    using SubscriptionPtr = std::shared_ptr<Subscription>;
+
+    ValueBus();
+
+    SubscriptionPtr subscribe(TopicFilter filter = {},
+                              SlowConsumerPolicy policy = SlowConsumerPolicy::Drop,
+                              std::size_t capacity = kDefaultCapacity);
+    void unsubscribe(const SubscriptionPtr& subscription);
+
+    // Must only be called from one thread at a time.
+    void publish(const ValueUpdate& update);
+
+    bool hasSubscribers() const { return m_count.load(std::memory_order_acquire) != 0; }
+    std::size_t subscriberCount() const { return m_count.load(std::memory_order_acquire); }
+    std::uint64_t published() const { return m_published.load(std::memory_order_relaxed); }
+
+private:
+    using List = std::vector<SubscriptionPtr>;
+
+    std::mutex m_mutex;  // subscribe/unsubscribe only
+    std::shared_ptr<const List> m_subscribers;
+    std::atomic<std::size_t> m_count{0};
+    std::atomic<std::uint64_t> m_published{0};
+};
+
+// Runs a callback for every update of a subscription on its own thread.
+// The callback must not re-enter the client feeding the bus: under
+// Backpressure that client's publisher may be waiting on this consumer.
+class CallbackConsumer {
+public:
+    using Callback = std::function<void(const ValueUpdate&)>;
+
+    CallbackConsumer(ValueBus& bus, Callback callback, TopicFilter filter = {},
+                     SlowConsumerPolicy policy = SlowConsumerPolicy::Drop,
+                     std::size_t capacity = ValueBus::kDefaultCapacity);
+    ~CallbackConsumer();
+
+    CallbackConsumer(const CallbackConsumer&) = delete;
+    CallbackConsumer& operator=(const CallbackConsumer&) = delete;
+
+    const ValueBus::Subscription& subscription() const { return *m_subscription; }
+
+private:
+    ValueBus& m_bus;
+    ValueBus::SubscriptionPtr m_subscription;
+    std::atomic<bool> m_stop{false};
+    std::thread m_thread;
+};
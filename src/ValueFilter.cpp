@@ -0,0 +1,161 @@
+#include "ValueFilter.h"
+#include <algorithm>
+#include <cmath>
+
+void ValueFilter::applyConfig(std::uint32_t tag, const FilterConfig* config) {
+    m_enabled[tag] = config != nullptr;
+    if (!config) return;
+    m_statusOnly[tag] = config->statusOnly;
+    m_absDeadband[tag] = std::max(0.0, config->absoluteDeadband);
+    m_pctDeadband[tag] = std::max(0.0, config->percentDeadband) / 100.0;
+    m_euSpan[tag] = std::abs(config->euHigh - config->euLow);
+    m_minInterval[tag] = std::max<std::int64_t>(0, config->minIntervalMs);
+    m_maxInterval[tag] = std::max<std::int64_t>(0, config->maxIntervalMs);
+}
+
+std::uint32_t ValueFilter::addTag(const std::string& nodeId, const FilterConfig* config) {
+    auto tag = static_cast<std::uint32_t>(m_enabled.size());
+    m_index.emplace(nodeId, tag);
+
+    m_enabled.push_back(0);
+    m_explicit.push_back(0);
+    m_statusOnly.push_back(0);
+    m_absDeadband.push_back(0.0);
+    m_pctDeadband.push_back(0.0);
+    m_euSpan.push_back(0.0);
+    m_minInterval.push_back(0);
+    m_maxInterval.push_back(0);
+
+    m_hasLast.push_back(0);
+    m_lastGood.push_back(0);
+    m_lastNumeric.push_back(0);
+    m_lastValue.push_back(0.0);
+    m_lastText.emplace_back();
+    m_lastPublish.push_back(0);
+
+    m_received.push_back(0);
+    m_published.push_back(0);
+
+    applyConfig(tag, config);
+    return tag;
+}
+
+std::uint32_t ValueFilter::tagIndex(const std::string& nodeId) {
+    auto it = m_index.find(nodeId);
+    if (it != m_index.end()) return it->second;
+    return addTag(nodeId, m_hasDefault ? &m_default : nullptr);
+}
+
+std::uint32_t ValueFilter::filterIndex(const std::string& nodeId) {
+    auto it = m_index.find(nodeId);
+    if (it != m_index.end()) return it->second;
+    return m_hasDefault ? addTag(nodeId, &m_default) : kPassThrough;
+}
+
+void ValueFilter::configure(const std::string& nodeId, const FilterConfig& config) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::uint32_t tag = tagIndex(nodeId);
+    m_explicit[tag] = 1;
+    applyConfig(tag, &config);
+}
+
+void ValueFilter::setDefault(const FilterConfig& config) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_default = config;
+    m_hasDefault = true;
+    for (std::uint32_t tag = 0; tag < m_explicit.size(); ++tag) {
+        if (!m_explicit[tag]) applyConfig(tag, &m_default);
+    }
+}
+
+void ValueFilter::clearDefault() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_hasDefault = false;
+    for (std::uint32_t tag = 0; tag < m_explicit.size(); ++tag) {
+        if (!m_explicit[tag]) applyConfig(tag, nullptr);
+    }
+}
+
+std::size_t ValueFilter::filter(const ValueUpdate* updates, std::size_t count, std::uint8_t* pass) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Resolve tag ids first so the decision loop below only touches arrays.
+    m_batchTags.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+        m_batchTags[i] = filterIndex(updates[i].nodeId);
+
+    std::size_t passed = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const ValueUpdate& u = updates[i];
+        const std::uint32_t k = m_batchTags[i];
+        if (k == kPassThrough) {
+            pass[i] = 1;
+            ++passed;
+            ++m_passThrough;
+            continue;
+        }
+        ++m_received[k];
+
+        bool publish = true;
+        if (m_enabled[k] && m_hasLast[k]) {
+            const std::int64_t elapsed = u.timestampMs - m_lastPublish[k];
+            const bool statusChanged = u.good != static_cast<bool>(m_lastGood[k]);
+
+            if (statusChanged) {
+                publish = true;
+            } else if (m_maxInterval[k] > 0 && elapsed >= m_maxInterval[k]) {
+                publish = true;
+            } else if (elapsed < m_minInterval[k] || m_statusOnly[k]) {
+                publish = false;
+            } else if (u.numeric && m_lastNumeric[k]) {
+                const double last = m_lastValue[k];
+                const double range = m_euSpan[k] > 0.0 ? m_euSpan[k] : std::abs(last);
+                const double threshold = std::max(m_absDeadband[k], m_pctDeadband[k] * range);
+                publish = std::abs(u.value - last) > threshold;
+            } else {
+                publish = u.numeric != static_cast<bool>(m_lastNumeric[k]) || u.text != m_lastText[k];
+            }
+        }
+
+        pass[i] = publish;
+        if (!publish) continue;
+
+        ++passed;
+        ++m_published[k];
+        m_hasLast[k] = 1;
+        m_lastGood[k] = u.good;
+        m_lastNumeric[k] = u.numeric;
+        m_lastValue[k] = u.value;
+        m_lastPublish[k] = u.timestampMs;
+        if (!u.numeric) m_lastText[k] = u.text;
+    }
+    return passed;
+}
+
+bool ValueFilter::accept(const ValueUpdate& update) {
+    std::uint8_t pass = 0;
+    filter(&update, 1, &pass);
+    return pass != 0;
+}
+
+ValueFilter::Stats ValueFilter::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats s;
+    s.received = s.published = m_passThrough;
+    for (std::size_t k = 0; k < m_received.size(); ++k) {
+        s.received += m_received[k];
+        s.published += m_published[k];
+    }
+    return s;
+}
+
+ValueFilter::Stats ValueFilter::stats(const std::string& nodeId) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats s;
+    auto it = m_index.find(nodeId);
+    if (it != m_index.end()) {
+        s.received = m_received[it->second];
+        s.published = m_published[it->second];
+    }
+    return s;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ValueBus.h"
+
+struct FilterConfig {
+    double absoluteDeadband{0.0};
+    // Percent of (euHigh - euLow); without a range, percent of the last
+    // published value's magnitude.
+    double percentDeadband{0.0};
+    double euLow{0.0};
+    double euHigh{0.0};
+    // Suppress value changes, publish only when good/bad status flips.
+    bool statusOnly{false};
+    // Changes arriving sooner than this after the last publish are dropped.
+    std::int64_t minIntervalMs{0};
+    // Republish an unchanged value after this long; 0 disables heartbeats.
+    std::int64_t maxIntervalMs{0};
+};
+
+// Per-tag change filter between the client and its consumers. Tags without
+// a configuration (and no default) pass through unchanged; they keep no
+// per-tag state and are counted only in the stats() totals.
+// Tag state is kept as parallel arrays indexed by a dense tag id, and
+// filter() evaluates whole batches in one loop over those arrays.
+class ValueFilter {
+public:
+    struct Stats {
+        std::uint64_t received{0};
+        std::uint64_t published{0};
+        double suppressionRatio() const {
+            return received ? 1.0 - double(published) / double(received) : 0.0;
+        }
+    };
+
+    void configure(const std::string& nodeId, const FilterConfig& config);
+    void setDefault(const FilterConfig& config);
+    void clearDefault();
+
+    // Sets pass[i] for each update and returns how many passed.
+    std::size_t filter(const ValueUpdate* updates, std::size_t count, std::uint8_t* pass);
+    bool accept(const ValueUpdate& update);
+
+    Stats stats() const;
+    // Zero for pass-through tags.
+    Stats stats(const std::string& nodeId) const;
+
+private:
+    static constexpr std::uint32_t kPassThrough = UINT32_MAX;
+
+    // kPassThrough for unknown tags while no default is set.
+    std::uint32_t filterIndex(const std::string& nodeId);
+    std::uint32_t tagIndex(const std::string& nodeId);
+    std::uint32_t addTag(const std::string& nodeId, const FilterConfig* config);
+    void applyConfig(std::uint32_t tag, const FilterConfig* config);
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, std::uint32_t> m_index;
+    bool m_hasDefault{false};
+    FilterConfig m_default;
+
+    // Configuration, one entry per tag.
+    std::vector<std::uint8_t> m_enabled;
+    std::vector<std::uint8_t> m_explicit;
+    std::vector<std::uint8_t> m_statusOnly;
+    std::vector<double> m_absDeadband;
+    std::vector<double> m_pctDeadband;
+    std::vector<double> m_euSpan;
+    std::vector<std::int64_t> m_minInterval;
+    std::vector<std::int64_t> m_maxInterval;
+
+    // Last published state.
+    std::vector<std::uint8_t> m_hasLast;
+    std::vector<std::uint8_t> m_lastGood;
+    std::vector<std::uint8_t> m_lastNumeric;
+    std::vector<double> m_lastValue;
+    std::vector<std::string> m_lastText;
+    std::vector<std::int64_t> m_lastPublish;
+
+    std::vector<std::uint64_t> m_received;
+    std::vector<std::uint64_t> m_published;
+    std::uint64_t m_passThrough{0};
+
+    // Gather buffers reused across batches.
+    std::vector<std::uint32_t> m_batchTags;
+};
@@ -1,4 +1,5 @@
 #include "mainwindow.h"
+#include "trendwidget.h"
 
 #include <QHBoxLayout>
 #include <QVBoxLayout>
@@ -9,11 +10,13 @@
 #include <QCheckBox>
 #include <QSpinBox>
 #include <QTimer>
+#include <QFileDialog>
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
 {
     m_client = std::make_unique<OpcUaClient>();
+    m_exportJob = std::make_unique<ExportJob>();
     setupUi();
 }
 
@@ -37,6 +40,7 @@ void MainWindow::setupUi()
 
     auto* browseLay = new QHBoxLayout();
     m_browse = new QPushButton("Обойти Objects");
+    m_export = new QPushButton("Экспорт...");
     m_auto = new QCheckBox("Автообновление");
     m_auto->setChecked(false); 
     m_interval = new QSpinBox();
@@ -44,6 +48,7 @@ void MainWindow::setupUi()
     m_interval->setValue(2);
 
     browseLay->addWidget(m_browse);
+    browseLay->addWidget(m_export);
     browseLay->addWidget(m_auto);
     browseLay->addWidget(new QLabel("Обновление (с):"));
     browseLay->addWidget(m_interval);
@@ -66,6 +71,8 @@ void MainWindow::setupUi()
     valueLay->addWidget(new QLabel("Тип:"));
     valueLay->addWidget(m_type);
 
+    m_trend = new TrendWidget();
+
     auto* writeLay = new QHBoxLayout();
     m_newValue = new QLineEdit();
     m_write = new QPushButton("Записать");
@@ -82,6 +89,7 @@ void MainWindow::setupUi()
     mainLay->addWidget(m_list);
     mainLay->addLayout(infoLay);
     mainLay->addLayout(valueLay);
+    mainLay->addWidget(m_trend);
     mainLay->addLayout(writeLay);
     mainLay->addWidget(m_status);
 
@@ -95,6 +103,11 @@ void MainWindow::setupUi()
             this, &MainWindow::onListSelectionChanged);
     connect(m_write, &QPushButton::clicked, this, &MainWindow::onWriteClicked);
     connect(m_auto, &QCheckBox::toggled, this, &MainWindow::onAutoRefreshToggled);
+    connect(m_export, &QPushButton::clicked, this, &MainWindow::onExportClicked);
+
+    m_exportTimer = new QTimer(this);
+    m_exportTimer->setInterval(250);
+    connect(m_exportTimer, &QTimer::timeout, this, &MainWindow::onExportProgress);
 
     auto* timer = new QTimer(this);
     connect(timer, &QTimer::timeout, this, [this]() {
@@ -117,6 +130,18 @@ void MainWindow::setStatus(const QString& s)
     m_status->setText(s);
 }
 
+void MainWindow::resubscribeHistory()
+{
+    // Subscribe to the trended tags only, so bulk reads such as an export
+    // neither reach the history nor push live samples out of the queue.
+    TopicFilter filter;
+    for (auto& nodeId : m_history.nodeIds()) filter.nodeIds.insert(std::move(nodeId));
+    m_historyFeed.reset();
+    m_historyFeed = std::make_unique<CallbackConsumer>(
+        m_client->value_bus(), [this](const ValueUpdate& u) { m_history.append(u); },
+        std::move(filter));
+}
+
 void MainWindow::onConnectClicked()
 {
     setStatus("Подключение...");
@@ -136,6 +161,8 @@ void MainWindow::onDisconnectClicked()
     m_selected->setText("-");
     m_currentValue->clear();
     m_type->setText("-");
+    m_trendNodeId.clear();
+    m_trend->setSeries(nullptr);
     setStatus("Отключено");
     m_connect->setEnabled(true);
     m_disconnect->setEnabled(false);
@@ -169,11 +196,21 @@ void MainWindow::onListSelectionChanged()
     auto* item = sel.first();
     QString nodeId = item->data(Qt::UserRole).toString();
 
-    auto val = m_client->read_value(nodeId.toStdString());
+    // Start recording before the read so its value is the first sample.
+    if (nodeId != m_trendNodeId) {
+        m_trendNodeId = nodeId;
+        m_trend->setSeries(m_history.series(nodeId.toStdString()));
+        resubscribeHistory();
+    }
+
+    auto val = m_client->read_values({nodeId.toStdString()}).front();
 
     m_selected->setText(nodeId);
-    m_currentValue->setText(QString::fromStdString(val.value));
-    m_type->setText(QString::fromStdString(val.type));
+    // Polling rereads the same value most of the time; skip the relayout.
+    QString value = QString::fromStdString(val.value);
+    QString type = QString::fromStdString(val.type);
+    if (m_currentValue->text() != value) m_currentValue->setText(value);
+    if (m_type->text() != type) m_type->setText(type);
 }
 
 void MainWindow::onWriteClicked()
@@ -203,4 +240,47 @@ void MainWindow::onAutoRefreshToggled(bool checked)
     } else {
         setStatus("Автообновление выключено");
     }
-}
\ No newline at end of file
+}
+
+void MainWindow::onExportClicked()
+{
+    if (!m_client->isConnected()) {
+        setStatus("Нет подключения");
+        return;
+    }
+    if (m_exportJob->isRunning()) {
+        m_exportJob->cancel();
+        return;
+    }
+
+    QString fileName = QFileDialog::getSaveFileName(this, "Экспорт адресного пространства",
+                                                    "export.uacol", "Columnar (*.uacol)");
+    if (fileName.isEmpty()) return;
+
+    if (m_exportJob->start(*m_client, fileName.toStdString())) {
+        m_export->setText("Отменить экспорт");
+        m_exportTimer->start();
+        setStatus("Экспорт...");
+    }
+}
+
+void MainWindow::onExportProgress()
+{
+    auto state = m_exportJob->state();
+    if (state == ExportJob::State::Running) {
+        setStatus(QString("Экспорт: %1 / %2")
+                      .arg(m_exportJob->rowsDone())
+                      .arg(m_exportJob->rowsTotal()));
+        return;
+    }
+
+    m_exportTimer->stop();
+    m_exportJob->wait();
+    m_export->setText("Экспорт...");
+    if (state == ExportJob::State::Finished)
+        setStatus(QString("Экспорт завершён: %1 строк").arg(m_exportJob->rowsDone()));
+    else if (state == ExportJob::State::Cancelled)
+        setStatus("Экспорт отменён");
+    else
+        setStatus("Ошибка экспорта");
+}
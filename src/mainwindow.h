@@ -9,8 +9,13 @@ class QLabel;
 class QCheckBox;
 class QSpinBox;
 class QListWidget;
+class QTimer;
 
 #include "OpcUaClient.h" 
+#include "ExportJob.h"
+#include "TrendSeries.h"
+
+class TrendWidget;
 
 class MainWindow : public QMainWindow
 {
@@ -22,6 +27,7 @@ public:
 private:
     void setupUi();
     void setStatus(const QString& s);
+    void resubscribeHistory();
 
 private slots:
     void onConnectClicked();
@@ -30,15 +36,22 @@ private slots:
     void onListSelectionChanged();
     void onWriteClicked();
     void onAutoRefreshToggled(bool checked);
+    void onExportClicked();
+    void onExportProgress();
 
 private:
     std::unique_ptr<OpcUaClient> m_client;
+    std::unique_ptr<ExportJob> m_exportJob;
+    TrendHistory m_history;
+    std::unique_ptr<CallbackConsumer> m_historyFeed;
 
     QLineEdit* m_url;
     QPushButton* m_connect;
     QPushButton* m_disconnect;
 
     QPushButton* m_browse;
+    QPushButton* m_export;
+    QTimer* m_exportTimer;
     QCheckBox* m_auto;
     QSpinBox* m_interval;
 
@@ -48,6 +61,9 @@ private:
     QLineEdit* m_currentValue;
     QLabel* m_type;
 
+    TrendWidget* m_trend;
+    QString m_trendNodeId;
+
     QLineEdit* m_newValue;
     QPushButton* m_write;
 
@@ -0,0 +1,159 @@
+#include "trendwidget.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPolygonF>
+#include <QTimer>
+#include <QWheelEvent>
+#include <algorithm>
+
+namespace {
+
+constexpr std::int64_t kMinSpanMs = 100;
+constexpr std::int64_t kMaxSpanMs = 10LL * 365 * 24 * 3600 * 1000;
+
+}
+
+TrendWidget::TrendWidget(QWidget* parent)
+    : QWidget(parent)
+{
+    setMinimumHeight(160);
+    setMouseTracking(false);
+
+    // Repaints are driven by this ~60 fps tick and only happen when the
+    // series or the view changed since the last frame.
+    m_frameTimer = new QTimer(this);
+    m_frameTimer->setInterval(16);
+    connect(m_frameTimer, &QTimer::timeout, this, &TrendWidget::onFrame);
+    m_frameTimer->start();
+}
+
+void TrendWidget::setSeries(std::shared_ptr<TrendSeries> series)
+{
+    m_series = std::move(series);
+    m_follow = true;
+    m_dirty = true;
+}
+
+void TrendWidget::onFrame()
+{
+    if (!isVisible()) return;
+    if (m_dirty || (m_series && m_series->version() != m_paintedVersion)) {
+        m_dirty = false;
+        update();
+    }
+}
+
+QRect TrendWidget::plotRect() const
+{
+    return rect().adjusted(60, 8, -8, -20);
+}
+
+std::int64_t TrendWidget::timeAt(int x) const
+{
+    QRect plot = plotRect();
+    double f = plot.width() > 0 ? double(x - plot.left()) / plot.width() : 1.0;
+    return m_viewEndMs - m_viewSpanMs + static_cast<std::int64_t>(f * m_viewSpanMs);
+}
+
+void TrendWidget::paintEvent(QPaintEvent*)
+{
+    QPainter p(this);
+    p.fillRect(rect(), palette().base());
+
+    QRect plot = plotRect();
+    p.setPen(palette().mid().color());
+    p.drawRect(plot);
+
+    std::int64_t firstMs = 0, lastMs = 0;
+    if (!m_series || plot.width() <= 0 || !m_series->timeRange(firstMs, lastMs)) {
+        p.setPen(palette().text().color());
+        p.drawText(plot, Qt::AlignCenter, "Нет данных");
+        return;
+    }
+
+    m_paintedVersion = m_series->version();
+    if (m_follow) m_viewEndMs = lastMs;
+    const std::int64_t t1 = m_viewEndMs;
+    const std::int64_t t0 = t1 - m_viewSpanMs;
+
+    auto points = m_series->query(t0, t1, static_cast<std::size_t>(plot.width()));
+    if (points.empty()) return;
+
+    auto [lo, hi] = std::minmax_element(points.begin(), points.end(),
+        [](const TrendPoint& a, const TrendPoint& b) { return a.value < b.value; });
+    double yMin = lo->value, yMax = hi->value;
+    if (yMax - yMin < 1e-9) {
+        yMin -= 0.5;
+        yMax += 0.5;
+    }
+
+    QPolygonF line;
+    line.reserve(static_cast<int>(points.size()));
+    const double xScale = double(plot.width()) / double(m_viewSpanMs);
+    const double yScale = double(plot.height()) / (yMax - yMin);
+    for (const auto& pt : points) {
+        line << QPointF(plot.left() + (pt.timestampMs - t0) * xScale,
+                        plot.bottom() - (pt.value - yMin) * yScale);
+    }
+
+    p.save();
+    p.setClipRect(plot);
+    p.setPen(QPen(palette().highlight().color(), 1.5));
+    p.drawPolyline(line);
+    p.restore();
+
+    p.setPen(palette().text().color());
+    p.drawText(QRect(0, plot.top(), plot.left() - 4, 16), Qt::AlignRight, QString::number(yMax, 'g', 6));
+    p.drawText(QRect(0, plot.bottom() - 16, plot.left() - 4, 16), Qt::AlignRight, QString::number(yMin, 'g', 6));
+    p.drawText(QRect(plot.left(), plot.bottom() + 2, plot.width(), 16), Qt::AlignRight,
+               QString("%1 с%2").arg(m_viewSpanMs / 1000.0).arg(m_follow ? "" : " (пауза)"));
+}
+
+void TrendWidget::wheelEvent(QWheelEvent* event)
+{
+    const double factor = event->angleDelta().y() > 0 ? 0.8 : 1.25;
+    auto span = static_cast<std::int64_t>(m_viewSpanMs * factor);
+    span = std::clamp(span, kMinSpanMs, kMaxSpanMs);
+
+    if (!m_follow) {
+        // Keep the time under the cursor in place.
+        std::int64_t anchor = timeAt(static_cast<int>(event->position().x()));
+        m_viewEndMs = anchor + static_cast<std::int64_t>(double(m_viewEndMs - anchor) * span / m_viewSpanMs);
+    }
+    m_viewSpanMs = span;
+    m_dirty = true;
+    event->accept();
+}
+
+void TrendWidget::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton) return;
+    m_dragging = true;
+    m_dragStart = event->pos();
+    m_dragStartEndMs = m_viewEndMs;
+}
+
+void TrendWidget::mouseMoveEvent(QMouseEvent* event)
+{
+    if (!m_dragging) return;
+    QRect plot = plotRect();
+    if (plot.width() <= 0) return;
+
+    int dx = event->pos().x() - m_dragStart.x();
+    if (dx == 0) return;
+    m_follow = false;
+    m_viewEndMs = m_dragStartEndMs - static_cast<std::int64_t>(double(dx) * m_viewSpanMs / plot.width());
+    m_dirty = true;
+}
+
+void TrendWidget::mouseReleaseEvent(QMouseEvent*)
+{
+    m_dragging = false;
+}
+
+void TrendWidget::mouseDoubleClickEvent(QMouseEvent*)
+{
+    m_follow = true;
+    m_dirty = true;
+}
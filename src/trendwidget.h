@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QWidget>
+#include <QPoint>
+#include <cstdint>
+#include <memory>
+
+#include "TrendSeries.h"
+
+class QTimer;
+
+// Trend chart for one TrendSeries. Each frame asks the series for at most
+// two points per pixel column, so drawing cost depends on the widget width,
+// not on the number of samples. Follows the newest data until the user pans
+// or zooms; a double click returns to following.
+class TrendWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit TrendWidget(QWidget* parent = nullptr);
+
+    void setSeries(std::shared_ptr<TrendSeries> series);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
+
+private:
+    void onFrame();
+    QRect plotRect() const;
+    std::int64_t timeAt(int x) const;
+
+    std::shared_ptr<TrendSeries> m_series;
+    QTimer* m_frameTimer;
+
+    bool m_follow{true};
+    std::int64_t m_viewEndMs{0};
+    std::int64_t m_viewSpanMs{60 * 1000};
+
+    bool m_dragging{false};
+    QPoint m_dragStart;
+    std::int64_t m_dragStartEndMs{0};
+
+    std::uint64_t m_paintedVersion{0};
+    bool m_dirty{true};
+};
@@ -0,0 +1,176 @@
+#include "CaptureLog.h"
+#include <iterator>
+
+namespace {
+
+const char kMagic[8] = {'U', 'A', 'C', 'A', 'P', '0', '1', '\0'};
+
+constexpr std::size_t kMaxDictionaryString = 128;
+constexpr std::size_t kMaxDictionaryEntries = 1u << 20;
+
+bool dictionaryAccepts(const std::string& s, std::size_t entries) {
+    return s.size() <= kMaxDictionaryString && entries < kMaxDictionaryEntries;
+}
+
+std::uint64_t zigzag(std::int64_t v) {
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t v) {
+    return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+class Decoder {
+public:
+    explicit Decoder(const std::string& data) : m_data(data) {}
+
+    bool atEnd() const { return m_pos >= m_data.size(); }
+
+    bool varint(std::uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (m_pos >= m_data.size()) return false;
+            auto byte = static_cast<unsigned char>(m_data[m_pos++]);
+            v |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool string(std::string& s) {
+        std::uint64_t tag = 0;
+        if (!varint(tag)) return false;
+        if (tag & 1) {
+            std::uint64_t ref = tag >> 1;
+            if (ref >= m_dictionary.size()) return false;
+            s = m_dictionary[ref];
+            return true;
+        }
+        std::uint64_t len = tag >> 1;
+        if (len > m_data.size() - m_pos) return false;
+        s.assign(m_data, m_pos, len);
+        m_pos += len;
+        if (dictionaryAccepts(s, m_dictionary.size())) m_dictionary.push_back(s);
+        return true;
+    }
+
+    bool strings(std::vector<std::string>& out) {
+        std::uint64_t count = 0;
+        if (!varint(count) || count > m_data.size() - m_pos) return false;
+        out.resize(count);
+        for (auto& s : out) {
+            if (!string(s)) return false;
+        }
+        return true;
+    }
+
+private:
+    const std::string& m_data;
+    std::size_t m_pos{sizeof(kMagic)};
+    std::vector<std::string> m_dictionary;
+};
+
+} // namespace
+
+CaptureWriter::~CaptureWriter() {
+    close();
+}
+
+bool CaptureWriter::open(const std::string& fileName) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_out.is_open()) m_out.close();
+    m_out.open(fileName, std::ios::binary | std::ios::trunc);
+    if (!m_out) return false;
+
+    m_out.write(kMagic, sizeof(kMagic));
+    m_origin = std::chrono::steady_clock::now();
+    m_lastStartUs = 0;
+    m_dictionary.clear();
+    return static_cast<bool>(m_out);
+}
+
+void CaptureWriter::close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_out.is_open()) m_out.close();
+}
+
+bool CaptureWriter::isOpen() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_out.is_open();
+}
+
+std::uint64_t CaptureWriter::nowUs() const {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - m_origin).count());
+}
+
+void CaptureWriter::putVarint(std::uint64_t v) {
+    char buf[10];
+    int n = 0;
+    do {
+        auto byte = static_cast<char>(v & 0x7F);
+        v >>= 7;
+        if (v) byte = static_cast<char>(byte | 0x80);
+        buf[n++] = byte;
+    } while (v);
+    m_out.write(buf, n);
+}
+
+void CaptureWriter::putString(const std::string& s) {
+    auto it = m_dictionary.find(s);
+    if (it != m_dictionary.end()) {
+        putVarint((static_cast<std::uint64_t>(it->second) << 1) | 1);
+        return;
+    }
+    putVarint(static_cast<std::uint64_t>(s.size()) << 1);
+    m_out.write(s.data(), static_cast<std::streamsize>(s.size()));
+    if (dictionaryAccepts(s, m_dictionary.size()))
+        m_dictionary.emplace(s, static_cast<std::uint32_t>(m_dictionary.size()));
+}
+
+void CaptureWriter::write(const CaptureRecord& record) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_out.is_open()) return;
+
+    // Concurrent callers may finish out of order, hence the signed delta.
+    putVarint(static_cast<std::uint64_t>(record.op));
+    putVarint(zigzag(static_cast<std::int64_t>(record.startUs - m_lastStartUs)));
+    putVarint(record.durationUs);
+    m_lastStartUs = record.startUs;
+
+    putVarint(record.request.size());
+    for (const auto& s : record.request) putString(s);
+    putVarint(record.response.size());
+    for (const auto& s : record.response) putString(s);
+}
+
+bool readCaptureLog(const std::string& fileName, std::vector<CaptureRecord>& records) {
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in) return false;
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(kMagic) || data.compare(0, sizeof(kMagic), kMagic, sizeof(kMagic)) != 0)
+        return false;
+
+    records.clear();
+    Decoder dec(data);
+    std::uint64_t lastStart = 0;
+    while (!dec.atEnd()) {
+        std::uint64_t op = 0, delta = 0, duration = 0;
+        CaptureRecord rec;
+        if (!dec.varint(op) || !dec.varint(delta) || !dec.varint(duration) ||
+            !dec.strings(rec.request) || !dec.strings(rec.response)) {
+            // A capture cut short by a crash keeps its complete records.
+            break;
+        }
+        if (op < static_cast<std::uint64_t>(CaptureOp::Connect) ||
+            op > static_cast<std::uint64_t>(CaptureOp::Fingerprint))
+            break;
+
+        lastStart += static_cast<std::uint64_t>(unzigzag(delta));
+        rec.op = static_cast<CaptureOp>(op);
+        rec.startUs = lastStart;
+        rec.durationUs = static_cast<std::uint32_t>(duration);
+        records.push_back(std::move(rec));
+    }
+    return true;
+}
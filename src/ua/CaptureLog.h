@@ -0,0 +1,63 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class CaptureOp : std::uint8_t {
+    Connect = 1,
+    Disconnect,
+    Browse,
+    BrowseInto,
+    Read,
+    Write,
+    Translate,
+    Fingerprint
+};
+
+// One client call. Request and response are flattened to strings:
+//   Connect     request {url}                 response {ok}
+//   Browse*     request {}                    response {nodeId, path, ...}
+//   Read        request {nodeId}              response {value, type}
+//   Write       request {nodeId, value}        response {ok}
+//   Translate   request {ns, path, ...}       response {nodeId, ...}
+//   Fingerprint request {}                    response {fingerprint}
+struct CaptureRecord {
+    CaptureOp op{CaptureOp::Connect};
+    std::uint64_t startUs{0};     // since the capture was opened
+    std::uint32_t durationUs{0};
+    std::vector<std::string> request;
+    std::vector<std::string> response;
+};
+
+// Binary capture log: an 8-byte magic followed by records of LEB128 varints.
+// Record start times are zigzag deltas from the previous record; strings go
+// through a back-reference dictionary so repeated NodeIds and paths cost a
+// couple of bytes after their first occurrence.
+class CaptureWriter {
+public:
+    CaptureWriter() = default;
+    ~CaptureWriter();
+
+    bool open(const std::string& fileName);
+    void close();
+    bool isOpen() const;
+
+    std::uint64_t nowUs() const;
+    void write(const CaptureRecord& record);
+
+private:
+    void putVarint(std::uint64_t v);
+    void putString(const std::string& s);
+
+    mutable std::mutex m_mutex;
+    std::ofstream m_out;
+    std::chrono::steady_clock::time_point m_origin;
+    std::uint64_t m_lastStartUs{0};
+    std::unordered_map<std::string, std::uint32_t> m_dictionary;
+};
+
+bool readCaptureLog(const std::string& fileName, std::vector<CaptureRecord>& records);
@@ -1,7 +1,24 @@
 #pragma once
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 #include "UaTypes.h"
+#include "NodeRegistry.h"
+
+// Runs one service request of a long operation such as browseInto(). Lets
+// the caller take its own lock per request rather than for the whole
+// operation; returning false without running the request aborts it.
+using RequestGate = std::function<bool(const std::function<void()>& request)>;
+
+// Runs the request through the gate, or directly without one.
+inline bool runRequest(const RequestGate& gate, const std::function<void()>& request) {
+    if (!gate) {
+        request();
+        return true;
+    }
+    return gate(request);
+}
 
 class IUaClient {
 public:
@@ -12,7 +29,38 @@ public:
     virtual bool isConnected() const = 0;
 
     virtual std::vector<BrowseItem> browseObjects() = 0;
+    // Fills the registry with the browsed address space. Backends that can
+    // walk the hierarchy override this to avoid building path strings. Every
+    // request to the server goes through the gate, if one is given.
+    virtual void browseInto(NodeRegistry& registry, const RequestGate& gate = {}) {
+        std::vector<BrowseItem> items;
+        if (runRequest(gate, [&] { items = browseObjects(); })) registry.addItems(items);
+    }
+    // Resolves display paths ("Device1 / Temperature") starting at the Objects
+    // folder. A segment may carry an explicit "<ns>:" prefix; otherwise
+    // browseNamespace is used. Unresolved paths come back as empty strings.
+    virtual std::vector<std::string> translateBrowsePaths(
+        const std::vector<std::string>& displayPaths, std::uint16_t browseNamespace) {
+        (void)browseNamespace;
+        NodeRegistry registry;
+        browseInto(registry);
+        return registry.findNodeIds(displayPaths);
+    }
+    // False when translateBrowsePaths() falls back to a full browse; callers
+    // resolving many batches should then browse once and use the registry.
+    virtual bool hasTranslateService() const { return false; }
+    // Identifies the server's current address-space model. Cached path
+    // resolutions are dropped when it changes; empty means unknown.
+    virtual std::string modelFingerprint() { return {}; }
+
     virtual ReadResult readValue(const std::string& nodeId) = 0;
+    // Reads several nodes; backends that can batch send one Read request.
+    virtual std::vector<ReadResult> readValues(const std::vector<std::string>& nodeIds) {
+        std::vector<ReadResult> results;
+        results.reserve(nodeIds.size());
+        for (const auto& id : nodeIds) results.push_back(readValue(id));
+        return results;
+    }
     virtual bool writeValue(const std::string& nodeId,
                             const std::string& value) = 0;
 };
@@ -0,0 +1,376 @@
+#include "NodeRegistry.h"
+#include <functional>
+#include <cstring>
+
+namespace {
+
+std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+std::uint64_t childKey(NodeIndex parent, std::uint32_t nameId) {
+    return mix((static_cast<std::uint64_t>(parent) << 32) | nameId);
+}
+
+struct ParsedNodeId {
+    std::uint16_t ns{0};
+    NodeIdKind kind{NodeIdKind::Opaque};
+    std::uint32_t numeric{0};
+    std::string_view ident;
+};
+
+bool parseUInt(std::string_view s, std::uint64_t limit, std::uint64_t& out) {
+    if (s.empty() || s.size() > 10) return false;
+    std::uint64_t v = 0;
+    for (char c : s) {
+        if (c < '0' || c > '9') return false;
+        v = v * 10 + static_cast<std::uint64_t>(c - '0');
+    }
+    if (v > limit) return false;
+    out = v;
+    return true;
+}
+
+// Accepts the "ns=<n>;<t>=<id>" / "<t>=<id>" forms produced by
+// Open62541Client; anything else is kept verbatim as an opaque id.
+ParsedNodeId parseNodeId(std::string_view s) {
+    ParsedNodeId p;
+    p.ident = s;
+
+    std::string_view rest = s;
+    std::uint64_t ns = 0;
+    if (rest.substr(0, 3) == "ns=") {
+        auto semi = rest.find(';');
+        if (semi == std::string_view::npos || !parseUInt(rest.substr(3, semi - 3), 0xFFFF, ns))
+            return p;
+        rest.remove_prefix(semi + 1);
+    }
+    if (rest.size() < 2 || rest[1] != '=') return p;
+
+    std::string_view ident = rest.substr(2);
+    switch (rest[0]) {
+    case 'i': {
+        std::uint64_t v = 0;
+        if (!parseUInt(ident, 0xFFFFFFFFu, v)) return p;
+        p.kind = NodeIdKind::Numeric;
+        p.numeric = static_cast<std::uint32_t>(v);
+        break;
+    }
+    case 's': p.kind = NodeIdKind::String; break;
+    case 'g': p.kind = NodeIdKind::Guid; break;
+    case 'b': p.kind = NodeIdKind::ByteString; break;
+    default: return p;
+    }
+    p.ns = static_cast<std::uint16_t>(ns);
+    p.ident = ident;
+    return p;
+}
+
+std::uint64_t packParts(std::uint16_t ns, NodeIdKind kind, std::uint32_t value) {
+    return (static_cast<std::uint64_t>(ns) << 48)
+         | (static_cast<std::uint64_t>(kind) << 40)
+         | value;
+}
+
+bool needsGrow(std::size_t count, std::size_t capacity) {
+    return (count + 1) * 10 > capacity * 7;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------- StringPool
+
+std::size_t StringPool::slotFor(std::string_view s) const {
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = mix(std::hash<std::string_view>{}(s)) & mask;
+    while (m_slots[slot] != kNotFound && m_views[m_slots[slot]] != s)
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+void StringPool::grow() {
+    std::vector<std::uint32_t> old;
+    old.swap(m_slots);
+    m_slots.assign(old.empty() ? 64 : old.size() * 2, kNotFound);
+    for (std::uint32_t id : old) {
+        if (id != kNotFound) m_slots[slotFor(m_views[id])] = id;
+    }
+}
+
+std::uint32_t StringPool::intern(std::string_view s) {
+    if (needsGrow(m_views.size(), m_slots.size())) grow();
+
+    std::size_t slot = slotFor(s);
+    if (m_slots[slot] != kNotFound) return m_slots[slot];
+
+    char* dst = nullptr;
+    if (s.empty()) {
+        // Needs no storage; the current block may not even exist yet.
+    } else if (s.size() > kBlockSize / 4) {
+        m_blocks.push_back(std::make_unique<char[]>(s.size()));
+        dst = m_blocks.back().get();
+        // Keep filling the current small-string block afterwards.
+        if (m_blocks.size() > 1) std::swap(m_blocks[m_blocks.size() - 1], m_blocks[m_blocks.size() - 2]);
+        m_bytes += s.size();
+    } else {
+        if (m_blockUsed + s.size() > kBlockSize) {
+            m_blocks.push_back(std::make_unique<char[]>(kBlockSize));
+            m_blockUsed = 0;
+            m_bytes += kBlockSize;
+        }
+        dst = m_blocks.back().get() + m_blockUsed;
+        m_blockUsed += s.size();
+    }
+    if (dst) std::memcpy(dst, s.data(), s.size());
+
+    auto id = static_cast<std::uint32_t>(m_views.size());
+    m_views.push_back(dst ? std::string_view(dst, s.size()) : std::string_view());
+    m_slots[slot] = id;
+    return id;
+}
+
+std::uint32_t StringPool::find(std::string_view s) const {
+    if (m_slots.empty()) return kNotFound;
+    return m_slots[slotFor(s)];
+}
+
+std::size_t StringPool::memoryUsage() const {
+    return m_bytes
+         + m_views.capacity() * sizeof(std::string_view)
+         + m_slots.capacity() * sizeof(std::uint32_t)
+         + m_blocks.capacity() * sizeof(std::unique_ptr<char[]>);
+}
+
+void StringPool::clear() {
+    m_blocks.clear();
+    m_blockUsed = kBlockSize;
+    m_bytes = 0;
+    m_views.clear();
+    m_slots.clear();
+}
+
+// -------------------------------------------------------------- NodeRegistry
+
+std::uint64_t NodeRegistry::pack(std::string_view nodeId) {
+    ParsedNodeId p = parseNodeId(nodeId);
+    if (p.kind == NodeIdKind::Numeric) return packParts(p.ns, p.kind, p.numeric);
+    return packParts(p.ns, p.kind, m_strings.intern(p.ident));
+}
+
+std::uint64_t NodeRegistry::packExisting(std::string_view nodeId) const {
+    ParsedNodeId p = parseNodeId(nodeId);
+    if (p.kind == NodeIdKind::Numeric) return packParts(p.ns, p.kind, p.numeric);
+    std::uint32_t id = m_strings.find(p.ident);
+    return id == StringPool::kNotFound ? 0 : packParts(p.ns, p.kind, id);
+}
+
+void NodeRegistry::indexId(NodeIndex index) {
+    if (needsGrow(m_idCount, m_idSlots.size())) {
+        std::vector<NodeIndex> old;
+        old.swap(m_idSlots);
+        m_idSlots.assign(old.empty() ? 64 : old.size() * 2, kInvalidNode);
+        m_idCount = 0;
+        for (NodeIndex i : old) {
+            if (i != kInvalidNode) indexId(i);
+        }
+    }
+    const std::size_t mask = m_idSlots.size() - 1;
+    std::size_t slot = mix(m_ids[index]) & mask;
+    while (m_idSlots[slot] != kInvalidNode) slot = (slot + 1) & mask;
+    m_idSlots[slot] = index;
+    ++m_idCount;
+}
+
+void NodeRegistry::indexChild(NodeIndex index) {
+    if (needsGrow(m_childCount, m_childSlots.size())) {
+        std::vector<NodeIndex> old;
+        old.swap(m_childSlots);
+        m_childSlots.assign(old.empty() ? 64 : old.size() * 2, kInvalidNode);
+        m_childCount = 0;
+        for (NodeIndex i : old) {
+            if (i != kInvalidNode) indexChild(i);
+        }
+    }
+    const std::size_t mask = m_childSlots.size() - 1;
+    std::size_t slot = childKey(m_parents[index], m_names[index]) & mask;
+    while (m_childSlots[slot] != kInvalidNode) slot = (slot + 1) & mask;
+    m_childSlots[slot] = index;
+    ++m_childCount;
+}
+
+NodeIndex NodeRegistry::findPacked(std::uint64_t packed) const {
+    if (packed == 0 || m_idSlots.empty()) return kInvalidNode;
+    const std::size_t mask = m_idSlots.size() - 1;
+    std::size_t slot = mix(packed) & mask;
+    while (m_idSlots[slot] != kInvalidNode) {
+        if (m_ids[m_idSlots[slot]] == packed) return m_idSlots[slot];
+        slot = (slot + 1) & mask;
+    }
+    return kInvalidNode;
+}
+
+NodeIndex NodeRegistry::findChildById(NodeIndex parent, std::uint32_t nameId) const {
+    if (nameId == StringPool::kNotFound || m_childSlots.empty()) return kInvalidNode;
+    const std::size_t mask = m_childSlots.size() - 1;
+    std::size_t slot = childKey(parent, nameId) & mask;
+    while (m_childSlots[slot] != kInvalidNode) {
+        NodeIndex i = m_childSlots[slot];
+        if (m_parents[i] == parent && m_names[i] == nameId) return i;
+        slot = (slot + 1) & mask;
+    }
+    return kInvalidNode;
+}
+
+NodeIndex NodeRegistry::add(std::string_view nodeId, NodeIndex parent, std::string_view browseName) {
+    std::uint64_t packed = nodeId.empty() ? 0 : pack(nodeId);
+    NodeIndex existing = findPacked(packed);
+    if (existing != kInvalidNode) return existing;
+
+    std::uint32_t nameId = m_strings.intern(browseName);
+    NodeIndex sibling = findChildById(parent, nameId);
+    if (sibling != kInvalidNode) {
+        if (packed == 0) return sibling;
+        if (m_ids[sibling] == 0) {
+            // A folder created by addPath() turned out to be a real node.
+            m_ids[sibling] = packed;
+            indexId(sibling);
+            return sibling;
+        }
+    }
+
+    if (m_ids.size() >= kInvalidNode) return kInvalidNode;
+
+    auto index = static_cast<NodeIndex>(m_ids.size());
+    m_ids.push_back(packed);
+    m_parents.push_back(parent);
+    m_names.push_back(nameId);
+
+    // Duplicate browse names under one parent keep the first node reachable
+    // by path; the others are still found by NodeId.
+    if (sibling == kInvalidNode) indexChild(index);
+    if (packed != 0) indexId(index);
+    return index;
+}
+
+NodeIndex NodeRegistry::addPath(std::string_view nodeId, std::string_view displayPath) {
+    NodeIndex parent = kInvalidNode;
+    for (;;) {
+        auto sep = displayPath.find(kPathSeparator);
+        if (sep == std::string_view::npos)
+            return add(nodeId, parent, displayPath);
+        parent = add({}, parent, displayPath.substr(0, sep));
+        if (parent == kInvalidNode) return kInvalidNode;
+        displayPath.remove_prefix(sep + kPathSeparator.size());
+    }
+}
+
+void NodeRegistry::addItems(const std::vector<BrowseItem>& items) {
+    for (const auto& item : items)
+        addPath(item.nodeId, item.displayPath);
+}
+
+NodeIndex NodeRegistry::find(std::string_view nodeId) const {
+    return findPacked(packExisting(nodeId));
+}
+
+NodeIndex NodeRegistry::findChild(NodeIndex parent, std::string_view browseName) const {
+    return findChildById(parent, m_strings.find(browseName));
+}
+
+NodeIndex NodeRegistry::findPath(std::string_view displayPath) const {
+    NodeIndex node = kInvalidNode;
+    for (;;) {
+        auto sep = displayPath.find(kPathSeparator);
+        node = findChild(node, displayPath.substr(0, sep));
+        if (node == kInvalidNode || sep == std::string_view::npos) return node;
+        displayPath.remove_prefix(sep + kPathSeparator.size());
+    }
+}
+
+std::vector<std::string> NodeRegistry::findNodeIds(const std::vector<std::string>& displayPaths) const {
+    std::vector<std::string> result;
+    result.reserve(displayPaths.size());
+    for (const auto& path : displayPaths) {
+        NodeIndex index = findPath(path);
+        result.push_back(index == kInvalidNode ? std::string() : nodeId(index));
+    }
+    return result;
+}
+
+std::string NodeRegistry::nodeId(NodeIndex index) const {
+    std::uint64_t packed = m_ids[index];
+    if (packed == 0) return {};
+
+    auto ns = static_cast<std::uint16_t>(packed >> 48);
+    auto kind = static_cast<NodeIdKind>((packed >> 40) & 0xFF);
+    auto value = static_cast<std::uint32_t>(packed);
+
+    if (kind == NodeIdKind::Opaque) return std::string(m_strings.view(value));
+
+    std::string out;
+    if (ns != 0) out = "ns=" + std::to_string(ns) + ";";
+    switch (kind) {
+    case NodeIdKind::Numeric: return out + "i=" + std::to_string(value);
+    case NodeIdKind::String: out += "s="; break;
+    case NodeIdKind::Guid: out += "g="; break;
+    case NodeIdKind::ByteString: out += "b="; break;
+    default: break;
+    }
+    out += m_strings.view(value);
+    return out;
+}
+
+std::string NodeRegistry::displayPath(NodeIndex index) const {
+    std::vector<NodeIndex> chain;
+    std::size_t length = 0;
+    for (NodeIndex i = index; i != kInvalidNode; i = m_parents[i]) {
+        chain.push_back(i);
+        length += browseName(i).size() + kPathSeparator.size();
+    }
+
+    std::string out;
+    out.reserve(length);
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        if (!out.empty()) out += kPathSeparator;
+        out += browseName(*it);
+    }
+    return out;
+}
+
+std::vector<BrowseItem> NodeRegistry::toBrowseItems() const {
+    std::vector<BrowseItem> items;
+    items.reserve(m_idCount);
+    for (NodeIndex i = 0; i < m_ids.size(); ++i) {
+        if (m_ids[i] != 0) items.push_back({nodeId(i), displayPath(i)});
+    }
+    return items;
+}
+
+std::size_t NodeRegistry::memoryUsage() const {
+    return m_ids.capacity() * sizeof(std::uint64_t)
+         + m_parents.capacity() * sizeof(NodeIndex)
+         + m_names.capacity() * sizeof(std::uint32_t)
+         + m_idSlots.capacity() * sizeof(NodeIndex)
+         + m_childSlots.capacity() * sizeof(NodeIndex)
+         + m_strings.memoryUsage();
+}
+
+void NodeRegistry::reserve(std::size_t nodes) {
+    m_ids.reserve(nodes);
+    m_parents.reserve(nodes);
+    m_names.reserve(nodes);
+}
+
+void NodeRegistry::clear() {
+    m_ids.clear();
+    m_parents.clear();
+    m_names.clear();
+    m_strings.clear();
+    m_idSlots.clear();
+    m_childSlots.clear();
+    m_idCount = 0;
+    m_childCount = 0;
+}
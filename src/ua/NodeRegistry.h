@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "UaTypes.h"
+
+using NodeIndex = std::uint32_t;
+constexpr NodeIndex kInvalidNode = 0xFFFFFFFFu;
+
+// Append-only string interner. Characters live in fixed-size blocks that are
+// never reallocated, so views returned by view() stay valid for the pool's
+// lifetime.
+class StringPool {
+public:
+    static constexpr std::uint32_t kNotFound = 0xFFFFFFFFu;
+
+    std::uint32_t intern(std::string_view s);
+    std::uint32_t find(std::string_view s) const;
+    std::string_view view(std::uint32_t id) const { return m_views[id]; }
+
+    std::size_t size() const { return m_views.size(); }
+    std::size_t memoryUsage() const;
+    void clear();
+
+private:
+    static constexpr std::size_t kBlockSize = 64 * 1024;
+
+    std::size_t slotFor(std::string_view s) const;
+    void grow();
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    std::size_t m_blockUsed{kBlockSize};
+    std::size_t m_bytes{0};
+    std::vector<std::string_view> m_views;
+    std::vector<std::uint32_t> m_slots;
+};
+
+enum class NodeIdKind : std::uint8_t {
+    None = 0,
+    Numeric,
+    String,
+    Guid,
+    ByteString,
+    Opaque
+};
+
+// Struct-of-arrays registry of browsed nodes. Each node costs a packed 64-bit
+// NodeId, a 32-bit parent index and a 32-bit browse name id; strings are
+// interned once and full paths are rebuilt from parent links on demand.
+// Lookups by NodeId and by (parent, browse name) go through open-addressing
+// tables of node indices.
+//
+// Packed NodeId layout: namespace in bits 48..63, NodeIdKind in bits 40..47,
+// numeric identifier or interned string id in bits 0..31. Zero means the node
+// has no NodeId (an intermediate folder created by addPath()).
+class NodeRegistry {
+public:
+    static constexpr std::string_view kPathSeparator = " / ";
+
+    NodeIndex add(std::string_view nodeId, NodeIndex parent, std::string_view browseName);
+    NodeIndex addPath(std::string_view nodeId, std::string_view displayPath);
+    void addItems(const std::vector<BrowseItem>& items);
+
+    NodeIndex find(std::string_view nodeId) const;
+    NodeIndex findChild(NodeIndex parent, std::string_view browseName) const;
+    NodeIndex findPath(std::string_view displayPath) const;
+    // NodeId per display path; empty for unknown paths and folders.
+    std::vector<std::string> findNodeIds(const std::vector<std::string>& displayPaths) const;
+
+    bool hasNodeId(NodeIndex index) const { return m_ids[index] != 0; }
+    std::string nodeId(NodeIndex index) const;
+    std::string displayPath(NodeIndex index) const;
+    std::string_view browseName(NodeIndex index) const { return m_strings.view(m_names[index]); }
+    NodeIndex parent(NodeIndex index) const { return m_parents[index]; }
+
+    // Column access for filtering and export loops.
+    const std::vector<std::uint64_t>& packedIds() const { return m_ids; }
+    const std::vector<NodeIndex>& parents() const { return m_parents; }
+    const std::vector<std::uint32_t>& nameIds() const { return m_names; }
+    const StringPool& strings() const { return m_strings; }
+
+    std::vector<BrowseItem> toBrowseItems() const;
+
+    std::size_t size() const { return m_ids.size(); }
+    bool empty() const { return m_ids.empty(); }
+    std::size_t memoryUsage() const;
+    void reserve(std::size_t nodes);
+    void clear();
+
+private:
+    std::uint64_t pack(std::string_view nodeId);
+    std::uint64_t packExisting(std::string_view nodeId) const;
+    NodeIndex findPacked(std::uint64_t packed) const;
+    NodeIndex findChildById(NodeIndex parent, std::uint32_t nameId) const;
+
+    void indexId(NodeIndex index);
+    void indexChild(NodeIndex index);
+
+    std::vector<std::uint64_t> m_ids;
+    std::vector<NodeIndex> m_parents;
+    std::vector<std::uint32_t> m_names;
+    StringPool m_strings;
+
+    std::vector<NodeIndex> m_idSlots;
+    std::vector<NodeIndex> m_childSlots;
+    std::size_t m_idCount{0};
+    std::size_t m_childCount{0};
+};
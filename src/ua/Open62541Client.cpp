@@ -1,6 +1,7 @@
 #include "Open62541Client.h"
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 
 #ifdef WITH_OPEN62541
 extern "C" {
@@ -98,48 +99,295 @@ std::vector<BrowseItem> Open62541Client::browseObjects() {
     return result;
 }
 
-ReadResult Open62541Client::readValue(const std::string& nodeId) {
-    ReadResult r{ "<error>", "-" };
 #ifdef WITH_OPEN62541
-    if (!m_connected || !m_client) return r;
+namespace {
 
-    UA_NodeId nid;
-    UA_String nodeIdStr = UA_STRING_ALLOC(nodeId.c_str());
-    UA_NodeId_parse(&nid, nodeIdStr);
-    UA_String_clear(&nodeIdStr);
+struct PendingBrowse {
+    UA_NodeId nodeId;
+    NodeIndex index;
+};
+
+constexpr size_t kBrowseBatch = 256;
+
+void collectReferences(NodeRegistry& registry, NodeIndex parent,
+                       const UA_ReferenceDescription* refs, size_t count,
+                       std::vector<PendingBrowse>& next) {
+    for (size_t k = 0; k < count; ++k) {
+        const UA_ReferenceDescription& ref = refs[k];
+        if (ref.nodeId.nodeId.namespaceIndex == 0) continue;
+
+        std::string id = nodeIdToString(ref.nodeId.nodeId);
+        if (id == "<unsupported>") continue;
+        // Already registered: either a cycle or a node reachable twice.
+        if (registry.find(id) != kInvalidNode) continue;
+
+        std::string name = uaStringToStd(ref.browseName.name);
+        if (parent == kInvalidNode && name == "Server") continue;
+
+        NodeIndex index = registry.add(id, parent, name);
+        if (index == kInvalidNode) continue;
+
+        if (ref.nodeClass == UA_NODECLASS_OBJECT) {
+            PendingBrowse p{UA_NODEID_NULL, index};
+            UA_NodeId_copy(&ref.nodeId.nodeId, &p.nodeId);
+            next.push_back(p);
+        }
+    }
+}
+
+} // namespace
+#endif
+
+void Open62541Client::browseInto(NodeRegistry& registry, const RequestGate& gate) {
+#ifdef WITH_OPEN62541
+    if (!m_connected || !m_client) return;
+
+    std::vector<PendingBrowse> frontier;
+    frontier.push_back({UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER), kInvalidNode});
+    bool aborted = false;
+
+    // The gate may release the caller's lock between requests, so the
+    // session is rechecked before every one of them.
+    auto browse = [&](const UA_BrowseRequest& req, UA_BrowseResponse& resp) {
+        return runRequest(gate, [&] {
+            if (m_connected && m_client) resp = UA_Client_Service_browse(m_client, req);
+        });
+    };
+    auto browseNext = [&](const UA_BrowseNextRequest& req, UA_BrowseNextResponse& resp) {
+        return runRequest(gate, [&] {
+            if (m_connected && m_client) resp = UA_Client_Service_browseNext(m_client, req);
+        });
+    };
+
+    while (!frontier.empty()) {
+        std::vector<PendingBrowse> next;
+
+        for (size_t start = 0; start < frontier.size() && !aborted; start += kBrowseBatch) {
+            size_t n = std::min(kBrowseBatch, frontier.size() - start);
+
+            UA_BrowseRequest bReq;
+            UA_BrowseRequest_init(&bReq);
+            bReq.nodesToBrowse = static_cast<UA_BrowseDescription*>(
+                UA_Array_new(n, &UA_TYPES[UA_TYPES_BROWSEDESCRIPTION]));
+            bReq.nodesToBrowseSize = n;
+            for (size_t i = 0; i < n; ++i) {
+                UA_BrowseDescription& d = bReq.nodesToBrowse[i];
+                UA_NodeId_copy(&frontier[start + i].nodeId, &d.nodeId);
+                d.browseDirection = UA_BROWSEDIRECTION_FORWARD;
+                d.referenceTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_HIERARCHICALREFERENCES);
+                d.includeSubtypes = true;
+                d.nodeClassMask = UA_NODECLASS_OBJECT | UA_NODECLASS_VARIABLE;
+                d.resultMask = UA_BROWSERESULTMASK_BROWSENAME | UA_BROWSERESULTMASK_NODECLASS;
+            }
+
+            UA_BrowseResponse bResp;
+            UA_BrowseResponse_init(&bResp);
+            aborted = !browse(bReq, bResp);
+
+            for (size_t i = 0; i < bResp.resultsSize && i < n && !aborted; ++i) {
+                const UA_BrowseResult& res = bResp.results[i];
+                NodeIndex parent = frontier[start + i].index;
+                collectReferences(registry, parent, res.references, res.referencesSize, next);
+
+                UA_ByteString cp;
+                UA_ByteString_init(&cp);
+                UA_ByteString_copy(&res.continuationPoint, &cp);
+                while (cp.length > 0) {
+                    UA_BrowseNextRequest nReq;
+                    UA_BrowseNextRequest_init(&nReq);
+                    nReq.continuationPoints = &cp;
+                    nReq.continuationPointsSize = 1;
+                    UA_BrowseNextResponse nResp;
+                    UA_BrowseNextResponse_init(&nResp);
+                    aborted = !browseNext(nReq, nResp);
+                    UA_ByteString_clear(&cp);
+                    if (nResp.resultsSize == 1 && !aborted) {
+                        const UA_BrowseResult& more = nResp.results[0];
+                        collectReferences(registry, parent, more.references, more.referencesSize, next);
+                        UA_ByteString_copy(&more.continuationPoint, &cp);
+                    }
+                    UA_BrowseNextResponse_clear(&nResp);
+                }
+            }
+
+            UA_BrowseRequest_clear(&bReq);
+            UA_BrowseResponse_clear(&bResp);
+        }
+
+        for (auto& p : frontier) UA_NodeId_clear(&p.nodeId);
+        frontier.swap(next);
+        if (aborted) {
+            for (auto& p : frontier) UA_NodeId_clear(&p.nodeId);
+            frontier.clear();
+        }
+    }
+#else
+    (void)registry;
+    (void)gate;
+#endif
+}
+
+#ifdef WITH_OPEN62541
+static void fillRelativePath(UA_RelativePath& rp, const std::string& displayPath,
+                             UA_UInt16 browseNamespace) {
+    std::vector<std::string> segments;
+    const std::string sep(NodeRegistry::kPathSeparator);
+    size_t pos = 0;
+    for (;;) {
+        size_t next = displayPath.find(sep, pos);
+        segments.push_back(displayPath.substr(pos, next - pos));
+        if (next == std::string::npos) break;
+        pos = next + sep.size();
+    }
+
+    rp.elements = static_cast<UA_RelativePathElement*>(
+        UA_Array_new(segments.size(), &UA_TYPES[UA_TYPES_RELATIVEPATHELEMENT]));
+    rp.elementsSize = segments.size();
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const std::string& seg = segments[i];
+        UA_UInt16 ns = browseNamespace;
+        std::string name = seg;
+        size_t colon = seg.find(':');
+        if (colon != std::string::npos && colon > 0 && colon <= 5 &&
+            seg.find_first_not_of("0123456789") == colon) {
+            ns = static_cast<UA_UInt16>(std::stoul(seg.substr(0, colon)));
+            name = seg.substr(colon + 1);
+        }
+
+        UA_RelativePathElement& el = rp.elements[i];
+        el.referenceTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_HIERARCHICALREFERENCES);
+        el.isInverse = false;
+        el.includeSubtypes = true;
+        el.targetName = UA_QUALIFIEDNAME_ALLOC(ns, name.c_str());
+    }
+}
+#endif
+
+std::vector<std::string> Open62541Client::translateBrowsePaths(
+    const std::vector<std::string>& displayPaths, std::uint16_t browseNamespace) {
+    std::vector<std::string> result(displayPaths.size());
+#ifdef WITH_OPEN62541
+    if (!m_connected || !m_client || displayPaths.empty()) return result;
+
+    UA_TranslateBrowsePathsToNodeIdsRequest req;
+    UA_TranslateBrowsePathsToNodeIdsRequest_init(&req);
+    req.browsePaths = static_cast<UA_BrowsePath*>(
+        UA_Array_new(displayPaths.size(), &UA_TYPES[UA_TYPES_BROWSEPATH]));
+    req.browsePathsSize = displayPaths.size();
+    for (size_t i = 0; i < displayPaths.size(); ++i) {
+        req.browsePaths[i].startingNode = UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER);
+        fillRelativePath(req.browsePaths[i].relativePath, displayPaths[i], browseNamespace);
+    }
+
+    UA_TranslateBrowsePathsToNodeIdsResponse resp =
+        UA_Client_Service_translateBrowsePathsToNodeIds(m_client, req);
+
+    for (size_t i = 0; i < resp.resultsSize && i < result.size(); ++i) {
+        const UA_BrowsePathResult& r = resp.results[i];
+        if (r.statusCode == UA_STATUSCODE_GOOD && r.targetsSize > 0)
+            result[i] = nodeIdToString(r.targets[0].targetId.nodeId);
+    }
+
+    UA_TranslateBrowsePathsToNodeIdsRequest_clear(&req);
+    UA_TranslateBrowsePathsToNodeIdsResponse_clear(&resp);
+#else
+    (void)browseNamespace;
+#endif
+    return result;
+}
+
+bool Open62541Client::hasTranslateService() const {
+    return true;
+}
+
+std::string Open62541Client::modelFingerprint() {
+    std::string fingerprint;
+#ifdef WITH_OPEN62541
+    if (!m_connected || !m_client) return fingerprint;
 
     UA_Variant value;
     UA_Variant_init(&value);
-    UA_StatusCode ret = UA_Client_readValueAttribute(m_client, nid, &value);
-
-    if (ret == UA_STATUSCODE_GOOD && UA_Variant_isScalar(&value)) {
-        if (value.type == &UA_TYPES[UA_TYPES_BOOLEAN]) {
-            r.value = (*(UA_Boolean*)value.data) ? "true" : "false"; r.type = "Boolean";
-        } else if (value.type == &UA_TYPES[UA_TYPES_INT16]) {
-            r.value = std::to_string(*(UA_Int16*)value.data); r.type = "Int16";
-        } else if (value.type == &UA_TYPES[UA_TYPES_INT32]) {
-            r.value = std::to_string(*(UA_Int32*)value.data); r.type = "Int32";
-        } else if (value.type == &UA_TYPES[UA_TYPES_INT64]) {
-            r.value = std::to_string(*(UA_Int64*)value.data); r.type = "Int64";
-        } else if (value.type == &UA_TYPES[UA_TYPES_UINT16]) {
-            r.value = std::to_string(*(UA_UInt16*)value.data); r.type = "UInt16";
-        } else if (value.type == &UA_TYPES[UA_TYPES_UINT32]) {
-            r.value = std::to_string(*(UA_UInt32*)value.data); r.type = "UInt32";
-        } else if (value.type == &UA_TYPES[UA_TYPES_FLOAT]) {
-            r.value = std::to_string(*(UA_Float*)value.data); r.type = "Float";
-        } else if (value.type == &UA_TYPES[UA_TYPES_DOUBLE]) {
-            r.value = std::to_string(*(UA_Double*)value.data); r.type = "Double";
-        } else if (value.type == &UA_TYPES[UA_TYPES_STRING]) {
-            r.value = uaStringToStd(*(UA_String*)value.data); r.type = "String";
-        } else {
-            r.value = "<unsupported>"; r.type = "Other";
+    UA_StatusCode ret = UA_Client_readValueAttribute(
+        m_client, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_NAMESPACEARRAY), &value);
+    if (ret == UA_STATUSCODE_GOOD && value.type == &UA_TYPES[UA_TYPES_STRING]) {
+        const UA_String* uris = static_cast<const UA_String*>(value.data);
+        for (size_t i = 0; i < value.arrayLength; ++i) {
+            fingerprint += uaStringToStd(uris[i]);
+            fingerprint += '\n';
         }
     }
+    UA_Variant_clear(&value);
 
+    // A server restart may load a different model under the same URIs.
+    UA_Variant_init(&value);
+    ret = UA_Client_readValueAttribute(
+        m_client, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERSTATUS_STARTTIME), &value);
+    if (ret == UA_STATUSCODE_GOOD && value.type == &UA_TYPES[UA_TYPES_DATETIME])
+        fingerprint += std::to_string(*static_cast<const UA_DateTime*>(value.data));
     UA_Variant_clear(&value);
-    UA_NodeId_clear(&nid);
 #endif
-    return r;
+    return fingerprint;
+}
+
+ReadResult Open62541Client::readValue(const std::string& nodeId) {
+    return readValues({nodeId}).front();
+}
+
+std::vector<ReadResult> Open62541Client::readValues(const std::vector<std::string>& nodeIds) {
+    std::vector<ReadResult> results(nodeIds.size(), ReadResult{ "<error>", "-" });
+#ifdef WITH_OPEN62541
+    if (!m_connected || !m_client || nodeIds.empty()) return results;
+
+    UA_ReadRequest req;
+    UA_ReadRequest_init(&req);
+    req.nodesToRead = static_cast<UA_ReadValueId*>(
+        UA_Array_new(nodeIds.size(), &UA_TYPES[UA_TYPES_READVALUEID]));
+    req.nodesToReadSize = nodeIds.size();
+    req.timestampsToReturn = UA_TIMESTAMPSTORETURN_NEITHER;
+    for (size_t i = 0; i < nodeIds.size(); ++i) {
+        UA_String nodeIdStr = UA_STRING_ALLOC(nodeIds[i].c_str());
+        UA_NodeId_parse(&req.nodesToRead[i].nodeId, nodeIdStr);
+        UA_String_clear(&nodeIdStr);
+        req.nodesToRead[i].attributeId = UA_ATTRIBUTEID_VALUE;
+    }
+
+    UA_ReadResponse resp = UA_Client_Service_read(m_client, req);
+
+    if (resp.responseHeader.serviceResult == UA_STATUSCODE_GOOD) {
+        for (size_t i = 0; i < resp.resultsSize && i < results.size(); ++i) {
+            const UA_DataValue& dv = resp.results[i];
+            if (!dv.hasValue || (dv.hasStatus && dv.status != UA_STATUSCODE_GOOD)) continue;
+            if (!UA_Variant_isScalar(&dv.value)) continue;
+            const UA_Variant& value = dv.value;
+            ReadResult& r = results[i];
+            if (value.type == &UA_TYPES[UA_TYPES_BOOLEAN]) {
+                r.value = (*(UA_Boolean*)value.data) ? "true" : "false"; r.type = "Boolean";
+            } else if (value.type == &UA_TYPES[UA_TYPES_INT16]) {
+                r.value = std::to_string(*(UA_Int16*)value.data); r.type = "Int16";
+            } else if (value.type == &UA_TYPES[UA_TYPES_INT32]) {
+                r.value = std::to_string(*(UA_Int32*)value.data); r.type = "Int32";
+            } else if (value.type == &UA_TYPES[UA_TYPES_INT64]) {
+                r.value = std::to_string(*(UA_Int64*)value.data); r.type = "Int64";
+            } else if (value.type == &UA_TYPES[UA_TYPES_UINT16]) {
+                r.value = std::to_string(*(UA_UInt16*)value.data); r.type = "UInt16";
+            } else if (value.type == &UA_TYPES[UA_TYPES_UINT32]) {
+                r.value = std::to_string(*(UA_UInt32*)value.data); r.type = "UInt32";
+            } else if (value.type == &UA_TYPES[UA_TYPES_FLOAT]) {
+                r.value = std::to_string(*(UA_Float*)value.data); r.type = "Float";
+            } else if (value.type == &UA_TYPES[UA_TYPES_DOUBLE]) {
+                r.value = std::to_string(*(UA_Double*)value.data); r.type = "Double";
+            } else if (value.type == &UA_TYPES[UA_TYPES_STRING]) {
+                r.value = uaStringToStd(*(UA_String*)value.data); r.type = "String";
+            } else {
+                r.value = "<unsupported>"; r.type = "Other";
+            }
+        }
+    }
+
+    UA_ReadRequest_clear(&req);
+    UA_ReadResponse_clear(&resp);
+#endif
+    return results;
 }
 
 bool Open62541Client::writeValue(const std::string& nodeId, const std::string& value) {
@@ -20,7 +20,13 @@ public:
     bool isConnected() const override;
 
     std::vector<BrowseItem> browseObjects() override;
+    void browseInto(NodeRegistry& registry, const RequestGate& gate) override;
+    std::vector<std::string> translateBrowsePaths(
+        const std::vector<std::string>& displayPaths, std::uint16_t browseNamespace) override;
+    bool hasTranslateService() const override;
+    std::string modelFingerprint() override;
     ReadResult readValue(const std::string& nodeId) override;
+    std::vector<ReadResult> readValues(const std::vector<std::string>& nodeIds) override;
     bool writeValue(const std::string& nodeId, const std::string& value) override;
 
 private:
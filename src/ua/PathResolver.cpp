@@ -0,0 +1,156 @@
+#include "PathResolver.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+const char* const kCacheHeader = "# opcua path cache v1";
+
+std::uint64_t fnv1a(const std::string& s) {
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+} // namespace
+
+PathResolver::PathResolver(IUaClient* client, std::size_t batchSize,
+                           std::uint16_t browseNamespace)
+    : m_client(client),
+      m_batchSize(batchSize == 0 ? kDefaultBatchSize : batchSize),
+      m_browseNamespace(browseNamespace) {}
+
+bool PathResolver::checkModel(const RequestGate& gate) {
+    const auto now = std::chrono::steady_clock::now();
+    if (m_modelChecked && now - m_lastCheck < m_recheckInterval) return true;
+
+    std::string model;
+    if (!runRequest(gate, [&] { model = m_client->modelFingerprint(); })) return false;
+    m_modelChecked = true;
+    m_lastCheck = now;
+
+    // An empty fingerprint says nothing about the model, so nothing cached
+    // before can be trusted.
+    const std::uint64_t fingerprint = fnv1a(model);
+    if (model.empty() || !m_fingerprintKnown || fingerprint != m_fingerprint) m_cache.clear();
+    m_fingerprint = fingerprint;
+    m_fingerprintKnown = !model.empty();
+    return true;
+}
+
+std::vector<std::string> PathResolver::resolve(const std::vector<std::string>& displayPaths,
+                                               const RequestGate& gate) {
+    std::vector<std::string> result(displayPaths.size());
+    if (!m_client) return result;
+    bool connected = false;
+    if (!runRequest(gate, [&] { connected = m_client->isConnected(); }) || !connected)
+        return result;
+    if (!checkModel(gate)) return result;
+
+    std::vector<std::string> pending;
+    std::unordered_map<std::string, std::vector<std::size_t>> waiting;
+    for (std::size_t i = 0; i < displayPaths.size(); ++i) {
+        auto it = m_cache.find(displayPaths[i]);
+        if (it != m_cache.end()) {
+            result[i] = it->second;
+            ++m_stats.hits;
+            continue;
+        }
+        ++m_stats.misses;
+        auto& slots = waiting[displayPaths[i]];
+        if (slots.empty()) pending.push_back(displayPaths[i]);
+        slots.push_back(i);
+    }
+
+    // Without a translate service every batch would browse the whole
+    // address space again, so browse once for this call instead.
+    const bool service = m_client->hasTranslateService();
+    NodeRegistry browsed;
+    if (!service && !pending.empty()) {
+        m_client->browseInto(browsed, gate);
+        ++m_stats.requests;
+    }
+
+    for (std::size_t start = 0; start < pending.size(); start += m_batchSize) {
+        std::size_t end = std::min(pending.size(), start + m_batchSize);
+        std::vector<std::string> batch(pending.begin() + start, pending.begin() + end);
+        std::vector<std::string> ids;
+        if (service) {
+            if (!runRequest(gate, [&] { ids = m_client->translateBrowsePaths(batch, m_browseNamespace); }))
+                break;
+            ++m_stats.requests;
+        } else {
+            ids = browsed.findNodeIds(batch);
+        }
+
+        for (std::size_t k = 0; k < batch.size(); ++k) {
+            const std::string& id = k < ids.size() ? ids[k] : std::string();
+            const auto& slots = waiting[batch[k]];
+            if (id.empty()) {
+                m_stats.unresolved += slots.size();
+                continue;
+            }
+            // Misses are not cached: the node may still be created later.
+            m_cache[batch[k]] = id;
+            for (std::size_t i : slots) result[i] = id;
+        }
+    }
+    return result;
+}
+
+std::string PathResolver::resolve(const std::string& displayPath) {
+    return resolve(std::vector<std::string>{displayPath}).front();
+}
+
+void PathResolver::invalidate() {
+    m_cache.clear();
+    m_modelChecked = false;
+}
+
+bool PathResolver::loadCache(const std::string& fileName) {
+    std::ifstream in(fileName);
+    if (!in) return false;
+
+    std::string line;
+    if (!std::getline(in, line) || line != kCacheHeader) return false;
+    if (!std::getline(in, line)) return false;
+
+    std::unordered_map<std::string, std::string> cache;
+    std::uint64_t fingerprint = 0;
+    try {
+        fingerprint = std::stoull(line, nullptr, 16);
+    } catch (...) {
+        return false;
+    }
+
+    while (std::getline(in, line)) {
+        auto tab = line.find('\t');
+        if (tab == std::string::npos) continue;
+        cache.emplace(line.substr(0, tab), line.substr(tab + 1));
+    }
+
+    m_cache = std::move(cache);
+    m_fingerprint = fingerprint;
+    m_fingerprintKnown = true;
+    m_modelChecked = false;
+    return true;
+}
+
+bool PathResolver::saveCache(const std::string& fileName) const {
+    if (!m_fingerprintKnown) return false;
+    std::ofstream out(fileName, std::ios::trunc);
+    if (!out) return false;
+
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(m_fingerprint));
+    out << kCacheHeader << '\n' << hex << '\n';
+    for (const auto& [path, nodeId] : m_cache) {
+        if (path.find_first_of("\t\n") != std::string::npos) continue;
+        out << path << '\t' << nodeId << '\n';
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "IUaClient.h"
+
+// Resolves display paths to NodeIds with batched TranslateBrowsePathsToNodeIds
+// calls and remembers the answers. The cache is keyed to the server's model
+// fingerprint and can be persisted, so a restart with an unchanged server
+// resolves a whole configuration without a single request. The fingerprint
+// is read on the first resolve after setClient(), invalidate() or
+// loadCache(), and again once the recheck interval has passed, so a model
+// change is noticed even without a ModelChangeEvent. A server that reports
+// no fingerprint gets no trusted cache: it is cleared on every check and
+// never saved.
+class PathResolver {
+public:
+    static constexpr std::size_t kDefaultBatchSize = 1000;
+    static constexpr std::uint16_t kDefaultBrowseNamespace = 2;
+    static constexpr std::chrono::milliseconds kDefaultRecheckInterval{60 * 1000};
+
+    struct Stats {
+        std::size_t hits{0};
+        std::size_t misses{0};
+        std::size_t requests{0};
+        std::size_t unresolved{0};
+    };
+
+    explicit PathResolver(IUaClient* client = nullptr,
+                          std::size_t batchSize = kDefaultBatchSize,
+                          std::uint16_t browseNamespace = kDefaultBrowseNamespace);
+
+    void setClient(IUaClient* client) {
+        m_client = client;
+        m_modelChecked = false;
+    }
+
+    // Every request to the server goes through the gate, if one is given.
+    std::vector<std::string> resolve(const std::vector<std::string>& displayPaths,
+                                     const RequestGate& gate = {});
+    std::string resolve(const std::string& displayPath);
+
+    // How long a fingerprint check is trusted; zero checks on every resolve.
+    void setRecheckInterval(std::chrono::milliseconds interval) { m_recheckInterval = interval; }
+
+    // Drops every cached entry and rechecks the model, e.g. after a
+    // ModelChangeEvent.
+    void invalidate();
+
+    bool loadCache(const std::string& fileName);
+    // Fails without writing while the model fingerprint is unknown.
+    bool saveCache(const std::string& fileName) const;
+
+    std::size_t cacheSize() const { return m_cache.size(); }
+    const Stats& stats() const { return m_stats; }
+
+private:
+    bool checkModel(const RequestGate& gate);
+
+    IUaClient* m_client;
+    std::size_t m_batchSize;
+    std::uint16_t m_browseNamespace;
+    std::uint64_t m_fingerprint{0};
+    bool m_fingerprintKnown{false};
+    bool m_modelChecked{false};
+    std::chrono::milliseconds m_recheckInterval{kDefaultRecheckInterval};
+    std::chrono::steady_clock::time_point m_lastCheck;
+    std::unordered_map<std::string, std::string> m_cache;
+    Stats m_stats;
+};
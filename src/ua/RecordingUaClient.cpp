@@ -0,0 +1,112 @@
+#include "RecordingUaClient.h"
+
+RecordingUaClient::RecordingUaClient(std::shared_ptr<IUaClient> inner,
+                                     std::shared_ptr<CaptureWriter> writer)
+    : m_inner(std::move(inner)), m_writer(std::move(writer)) {}
+
+void RecordingUaClient::record(CaptureOp op, std::uint64_t startUs,
+                               std::vector<std::string> request,
+                               std::vector<std::string> response) {
+    CaptureRecord rec;
+    rec.op = op;
+    rec.startUs = startUs;
+    rec.durationUs = static_cast<std::uint32_t>(m_writer->nowUs() - startUs);
+    rec.request = std::move(request);
+    rec.response = std::move(response);
+    m_writer->write(rec);
+}
+
+bool RecordingUaClient::connect(const std::string& url) {
+    auto start = m_writer->nowUs();
+    bool ok = m_inner->connect(url);
+    record(CaptureOp::Connect, start, {url}, {ok ? "1" : "0"});
+    return ok;
+}
+
+void RecordingUaClient::disconnect() {
+    auto start = m_writer->nowUs();
+    m_inner->disconnect();
+    record(CaptureOp::Disconnect, start, {}, {});
+}
+
+bool RecordingUaClient::isConnected() const {
+    return m_inner->isConnected();
+}
+
+std::vector<BrowseItem> RecordingUaClient::browseObjects() {
+    auto start = m_writer->nowUs();
+    auto items = m_inner->browseObjects();
+
+    std::vector<std::string> response;
+    response.reserve(items.size() * 2);
+    for (const auto& item : items) {
+        response.push_back(item.nodeId);
+        response.push_back(item.displayPath);
+    }
+    record(CaptureOp::Browse, start, {}, std::move(response));
+    return items;
+}
+
+void RecordingUaClient::browseInto(NodeRegistry& registry, const RequestGate& gate) {
+    auto start = m_writer->nowUs();
+    auto first = static_cast<NodeIndex>(registry.size());
+    m_inner->browseInto(registry, gate);
+
+    // Only nodes added by this browse; folders without NodeId are implied
+    // by the paths of their children.
+    std::vector<std::string> response;
+    for (NodeIndex i = first; i < registry.size(); ++i) {
+        if (!registry.hasNodeId(i)) continue;
+        response.push_back(registry.nodeId(i));
+        response.push_back(registry.displayPath(i));
+    }
+    record(CaptureOp::BrowseInto, start, {}, std::move(response));
+}
+
+std::vector<std::string> RecordingUaClient::translateBrowsePaths(
+    const std::vector<std::string>& displayPaths, std::uint16_t browseNamespace) {
+    auto start = m_writer->nowUs();
+    auto ids = m_inner->translateBrowsePaths(displayPaths, browseNamespace);
+
+    std::vector<std::string> request;
+    request.reserve(displayPaths.size() + 1);
+    request.push_back(std::to_string(browseNamespace));
+    request.insert(request.end(), displayPaths.begin(), displayPaths.end());
+    record(CaptureOp::Translate, start, std::move(request), ids);
+    return ids;
+}
+
+bool RecordingUaClient::hasTranslateService() const {
+    return m_inner->hasTranslateService();
+}
+
+std::string RecordingUaClient::modelFingerprint() {
+    auto start = m_writer->nowUs();
+    auto fingerprint = m_inner->modelFingerprint();
+    record(CaptureOp::Fingerprint, start, {}, {fingerprint});
+    return fingerprint;
+}
+
+ReadResult RecordingUaClient::readValue(const std::string& nodeId) {
+    auto start = m_writer->nowUs();
+    auto r = m_inner->readValue(nodeId);
+    record(CaptureOp::Read, start, {nodeId}, {r.value, r.type});
+    return r;
+}
+
+std::vector<ReadResult> RecordingUaClient::readValues(const std::vector<std::string>& nodeIds) {
+    auto start = m_writer->nowUs();
+    auto results = m_inner->readValues(nodeIds);
+    // One record per node, so a replay answers single and batched reads alike.
+    for (std::size_t i = 0; i < results.size() && i < nodeIds.size(); ++i)
+        record(CaptureOp::Read, start, {nodeIds[i]}, {results[i].value, results[i].type});
+    return results;
+}
+
+bool RecordingUaClient::writeValue(const std::string& nodeId,
+                                   const std::string& value) {
+    auto start = m_writer->nowUs();
+    bool ok = m_inner->writeValue(nodeId, value);
+    record(CaptureOp::Write, start, {nodeId, value}, {ok ? "1" : "0"});
+    return ok;
+}
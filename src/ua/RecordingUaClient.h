@@ -0,0 +1,40 @@
+#pragma once
+#include <memory>
+#include "IUaClient.h"
+#include "CaptureLog.h"
+
+// Decorator that forwards every call to the wrapped client and appends the
+// request, response and timing to a capture log for ReplayUaClient.
+class RecordingUaClient final : public IUaClient {
+public:
+    RecordingUaClient(std::shared_ptr<IUaClient> inner,
+                      std::shared_ptr<CaptureWriter> writer);
+
+    bool connect(const std::string& url) override;
+    void disconnect() override;
+    bool isConnected() const override;
+
+    std::vector<BrowseItem> browseObjects() override;
+    void browseInto(NodeRegistry& registry, const RequestGate& gate) override;
+    std::vector<std::string> translateBrowsePaths(
+        const std::vector<std::string>& displayPaths, std::uint16_t browseNamespace) override;
+    bool hasTranslateService() const override;
+    std::string modelFingerprint() override;
+
+    ReadResult readValue(const std::string& nodeId) override;
+    std::vector<ReadResult> readValues(const std::vector<std::string>& nodeIds) override;
+    bool writeValue(const std::string& nodeId,
+                    const std::string& value) override;
+
+    // The wrapped client, session intact. The wrapper stays usable, e.g.
+    // by a browse still running on it; once the writer is closed it only
+    // forwards.
+    std::shared_ptr<IUaClient> inner() const { return m_inner; }
+
+private:
+    void record(CaptureOp op, std::uint64_t startUs,
+                std::vector<std::string> request, std::vector<std::string> response);
+
+    std::shared_ptr<IUaClient> m_inner;
+    std::shared_ptr<CaptureWriter> m_writer;
+};
@@ -0,0 +1,136 @@
+#include "ReplayUaClient.h"
+#include <algorithm>
+#include <thread>
+
+ReplayUaClient::ReplayUaClient(std::vector<CaptureRecord> records, ReplayPacing pacing)
+    : m_records(std::move(records)), m_pacing(pacing) {
+    for (std::size_t i = 0; i < m_records.size(); ++i) {
+        const auto& rec = m_records[i];
+        m_queues[key(rec.op, rec.request)].records.push_back(i);
+    }
+    if (!m_records.empty()) {
+        m_firstStartUs = std::min_element(m_records.begin(), m_records.end(),
+            [](const CaptureRecord& a, const CaptureRecord& b) { return a.startUs < b.startUs; })->startUs;
+    }
+}
+
+std::unique_ptr<ReplayUaClient> ReplayUaClient::open(const std::string& fileName,
+                                                     ReplayPacing pacing) {
+    std::vector<CaptureRecord> records;
+    if (!readCaptureLog(fileName, records)) return nullptr;
+    return std::make_unique<ReplayUaClient>(std::move(records), pacing);
+}
+
+std::string ReplayUaClient::key(CaptureOp op, const std::vector<std::string>& request) {
+    std::string k(1, static_cast<char>(op));
+    for (const auto& s : request) {
+        k += '\0';
+        k += s;
+    }
+    return k;
+}
+
+const CaptureRecord* ReplayUaClient::take(CaptureOp op, const std::vector<std::string>& request) {
+    auto callStart = std::chrono::steady_clock::now();
+
+    auto it = m_queues.find(key(op, request));
+    if (it == m_queues.end()) {
+        ++m_unmatched;
+        return nullptr;
+    }
+
+    Queue& q = it->second;
+    const CaptureRecord& rec = m_records[q.records[q.next]];
+    if (q.next + 1 < q.records.size()) ++q.next;
+
+    if (m_pacing == ReplayPacing::Original) {
+        // Never answer faster than the server did, and never run ahead of
+        // the recorded timeline.
+        std::chrono::microseconds latency(rec.durationUs);
+        std::chrono::microseconds offset(rec.startUs - m_firstStartUs + rec.durationUs);
+        std::this_thread::sleep_until(std::max(callStart + latency, m_replayStart + offset));
+    }
+    return &rec;
+}
+
+bool ReplayUaClient::connect(const std::string& url) {
+    if (m_records.empty()) return false;
+    m_replayStart = std::chrono::steady_clock::now();
+    // A replay is always "connected"; a recorded connect only sets pacing.
+    if (m_queues.count(key(CaptureOp::Connect, {url}))) take(CaptureOp::Connect, {url});
+    m_connected = true;
+    return true;
+}
+
+void ReplayUaClient::disconnect() {
+    if (m_connected) take(CaptureOp::Disconnect, {});
+    m_connected = false;
+}
+
+bool ReplayUaClient::isConnected() const {
+    return m_connected;
+}
+
+std::vector<BrowseItem> ReplayUaClient::takeBrowse(CaptureOp op) {
+    std::vector<BrowseItem> items;
+    if (!m_connected) return items;
+    const CaptureRecord* rec = take(op, {});
+    if (!rec) return items;
+
+    items.reserve(rec->response.size() / 2);
+    for (std::size_t i = 0; i + 1 < rec->response.size(); i += 2)
+        items.push_back({rec->response[i], rec->response[i + 1]});
+    return items;
+}
+
+std::vector<BrowseItem> ReplayUaClient::browseObjects() {
+    return takeBrowse(CaptureOp::Browse);
+}
+
+void ReplayUaClient::browseInto(NodeRegistry& registry, const RequestGate& gate) {
+    std::vector<BrowseItem> items;
+    if (runRequest(gate, [&] { items = takeBrowse(CaptureOp::BrowseInto); }))
+        registry.addItems(items);
+}
+
+std::vector<std::string> ReplayUaClient::translateBrowsePaths(
+    const std::vector<std::string>& displayPaths, std::uint16_t browseNamespace) {
+    std::vector<std::string> ids(displayPaths.size());
+    if (!m_connected) return ids;
+
+    std::vector<std::string> request;
+    request.reserve(displayPaths.size() + 1);
+    request.push_back(std::to_string(browseNamespace));
+    request.insert(request.end(), displayPaths.begin(), displayPaths.end());
+
+    const CaptureRecord* rec = take(CaptureOp::Translate, request);
+    if (rec) {
+        std::copy_n(rec->response.begin(), std::min(ids.size(), rec->response.size()), ids.begin());
+    }
+    return ids;
+}
+
+bool ReplayUaClient::hasTranslateService() const {
+    // Recorded translations are answered from the log.
+    return true;
+}
+
+std::string ReplayUaClient::modelFingerprint() {
+    if (!m_connected) return {};
+    const CaptureRecord* rec = take(CaptureOp::Fingerprint, {});
+    return rec && !rec->response.empty() ? rec->response[0] : std::string();
+}
+
+ReadResult ReplayUaClient::readValue(const std::string& nodeId) {
+    if (!m_connected) return {"<error>", "-"};
+    const CaptureRecord* rec = take(CaptureOp::Read, {nodeId});
+    if (!rec || rec->response.size() < 2) return {"<error>", "-"};
+    return {rec->response[0], rec->response[1]};
+}
+
+bool ReplayUaClient::writeValue(const std::string& nodeId,
+                                const std::string& value) {
+    if (!m_connected) return false;
+    const CaptureRecord* rec = take(CaptureOp::Write, {nodeId, value});
+    return rec && !rec->response.empty() && rec->response[0] == "1";
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "IUaClient.h"
+#include "CaptureLog.h"
+
+enum class ReplayPacing {
+    Original,          // keep recorded latencies and inter-request gaps
+    AsFastAsPossible
+};
+
+// Serves a capture log as an IUaClient. Calls are matched to recorded ones by
+// operation and request; repeated identical requests get their recorded
+// responses in order, and the last one is reused once they run out, so the
+// same call sequence always yields the same results.
+class ReplayUaClient final : public IUaClient {
+public:
+    explicit ReplayUaClient(std::vector<CaptureRecord> records,
+                            ReplayPacing pacing = ReplayPacing::AsFastAsPossible);
+
+    static std::unique_ptr<ReplayUaClient> open(const std::string& fileName,
+                                                ReplayPacing pacing = ReplayPacing::AsFastAsPossible);
+
+    bool connect(const std::string& url) override;
+    void disconnect() override;
+    bool isConnected() const override;
+
+    std::vector<BrowseItem> browseObjects() override;
+    void browseInto(NodeRegistry& registry, const RequestGate& gate) override;
+    std::vector<std::string> translateBrowsePaths(
+        const std::vector<std::string>& displayPaths, std::uint16_t browseNamespace) override;
+    bool hasTranslateService() const override;
+    std::string modelFingerprint() override;
+
+    ReadResult readValue(const std::string& nodeId) override;
+    bool writeValue(const std::string& nodeId,
+                    const std::string& value) override;
+
+    std::size_t recordCount() const { return m_records.size(); }
+    std::size_t unmatchedCalls() const { return m_unmatched; }
+
+private:
+    struct Queue {
+        std::vector<std::size_t> records;
+        std::size_t next{0};
+    };
+
+    static std::string key(CaptureOp op, const std::vector<std::string>& request);
+    const CaptureRecord* take(CaptureOp op, const std::vector<std::string>& request);
+    std::vector<BrowseItem> takeBrowse(CaptureOp op);
+
+    std::vector<CaptureRecord> m_records;
+    std::unordered_map<std::string, Queue> m_queues;
+    ReplayPacing m_pacing;
+    bool m_connected{false};
+    std::size_t m_unmatched{0};
+    std::chrono::steady_clock::time_point m_replayStart;
+    std::uint64_t m_firstStartUs{0};
+};
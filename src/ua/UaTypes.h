@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdlib>
 #include <string>
 
 struct BrowseItem {
@@ -10,3 +11,17 @@ struct ReadResult {
     std::string value;
     std::string type;
 };
+
+// Numeric view of a read result: Boolean maps to 0/1, the integer and
+// floating types to their value. Returns false for strings and errors.
+inline bool toNumber(const ReadResult& r, double& out) {
+    if (r.type == "Boolean") {
+        out = (r.value == "true") ? 1.0 : 0.0;
+        return true;
+    }
+    if (r.type == "String" || r.type == "Other" || r.type == "-" || r.value.empty())
+        return false;
+    char* end = nullptr;
+    out = std::strtod(r.value.c_str(), &end);
+    return end && *end == '\0';
+}
@@ -1,6 +1,16 @@
 #include "OpcUaClient.h"
+#include "ExportJob.h"
+#include "TrendSeries.h"
+#include "ua/MockUaClient.h"
+#include "ua/RecordingUaClient.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <chrono>
+#include <cstdio>
 #include <iostream>
+#include <thread>
 
 TEST(OpcUaClientTest, InitialStateNotConnected)
 {
@@ -122,6 +132,699 @@ TEST(OpcUaClientTest, RealServerIntegrationTest)
     }
 }
 
+TEST(NodeRegistryTest, LookupByNodeIdAndPath)
+{
+    OpcUaClient client;
+    client.connect("opc.tcp://localhost:4840");
+
+    NodeRegistry registry;
+    ASSERT_TRUE(client.browse_into(registry));
+
+    auto items = client.browse_objects();
+    for (const auto& item : items) {
+        NodeIndex byId = registry.find(item.nodeId);
+        ASSERT_NE(byId, kInvalidNode);
+        EXPECT_EQ(registry.findPath(item.displayPath), byId);
+        EXPECT_EQ(registry.nodeId(byId), item.nodeId);
+        EXPECT_EQ(registry.displayPath(byId), item.displayPath);
+    }
+
+    NodeIndex folder = registry.findPath("Device1");
+    ASSERT_NE(folder, kInvalidNode);
+    EXPECT_FALSE(registry.hasNodeId(folder));
+    EXPECT_EQ(registry.parent(registry.find("ns=2;i=1")), folder);
+    EXPECT_EQ(registry.toBrowseItems().size(), items.size());
+
+    EXPECT_EQ(registry.find("ns=2;i=999"), kInvalidNode);
+    EXPECT_EQ(registry.findPath("Device1 / Missing"), kInvalidNode);
+
+    std::atomic<bool> cancel{true};
+    NodeRegistry cancelled;
+    EXPECT_FALSE(client.browse_into(cancelled, &cancel));
+    EXPECT_TRUE(cancelled.empty());
+}
+
+TEST(NodeRegistryTest, CompactForLargeAddressSpaces)
+{
+    NodeRegistry registry;
+    const NodeIndex kDevices = 2000;
+    const NodeIndex kTags = 100;
+    registry.reserve(kDevices * (kTags + 1));
+
+    for (NodeIndex d = 0; d < kDevices; ++d) {
+        std::string device = "Device" + std::to_string(d);
+        NodeIndex parent = registry.add("ns=3;s=" + device, kInvalidNode, device);
+        for (NodeIndex t = 0; t < kTags; ++t) {
+            registry.add("ns=2;i=" + std::to_string(d * kTags + t), parent,
+                         "Tag" + std::to_string(t));
+        }
+    }
+
+    ASSERT_EQ(registry.size(), static_cast<size_t>(kDevices * (kTags + 1)));
+    EXPECT_LT(registry.memoryUsage() / registry.size(), 64u);
+
+    NodeIndex tag = registry.findPath("Device1234 / Tag56");
+    ASSERT_NE(tag, kInvalidNode);
+    EXPECT_EQ(registry.nodeId(tag), "ns=2;i=123456");
+    EXPECT_EQ(registry.find("ns=3;s=Device1234"), registry.parent(tag));
+}
+
+TEST(NodeRegistryTest, EmptyStringsAsFirstEntries)
+{
+    NodeRegistry byPath;
+    NodeIndex unnamed = byPath.addPath("ns=2;i=1", "");
+    ASSERT_NE(unnamed, kInvalidNode);
+    EXPECT_EQ(byPath.browseName(unnamed), "");
+    EXPECT_EQ(byPath.find("ns=2;i=1"), unnamed);
+
+    NodeRegistry byId;
+    NodeIndex empty = byId.add("ns=2;s=", kInvalidNode, "Empty");
+    NodeIndex child = byId.add("ns=2;s=Child", empty, "");
+    EXPECT_EQ(byId.find("ns=2;s="), empty);
+    EXPECT_EQ(byId.nodeId(empty), "ns=2;s=");
+    EXPECT_EQ(byId.findChild(empty, ""), child);
+    EXPECT_EQ(byId.browseName(child), "");
+}
+
+class CountingUaClient : public IUaClient {
+public:
+    bool connect(const std::string& url) override { return mock.connect(url); }
+    void disconnect() override { mock.disconnect(); }
+    bool isConnected() const override { return mock.isConnected(); }
+    std::vector<BrowseItem> browseObjects() override {
+        ++browseCalls;
+        return mock.browseObjects();
+    }
+    ReadResult readValue(const std::string& nodeId) override { return mock.readValue(nodeId); }
+    bool writeValue(const std::string& nodeId, const std::string& value) override {
+        return mock.writeValue(nodeId, value);
+    }
+
+    std::vector<std::string> translateBrowsePaths(
+        const std::vector<std::string>& displayPaths, std::uint16_t browseNamespace) override {
+        ++translateCalls;
+        largestBatch = std::max(largestBatch, displayPaths.size());
+        return IUaClient::translateBrowsePaths(displayPaths, browseNamespace);
+    }
+    bool hasTranslateService() const override { return translateService; }
+    std::string modelFingerprint() override {
+        ++fingerprintCalls;
+        return fingerprint;
+    }
+
+    MockUaClient mock;
+    bool translateService{true};
+    size_t browseCalls{0};
+    size_t fingerprintCalls{0};
+    size_t translateCalls{0};
+    size_t largestBatch{0};
+    std::string fingerprint{"model-1"};
+};
+
+TEST(PathResolverTest, BatchesAndCachesTranslations)
+{
+    CountingUaClient ua;
+    ua.connect("opc.tcp://localhost:4840");
+    PathResolver resolver(&ua, 4);
+
+    std::vector<std::string> paths;
+    for (const auto& item : ua.browseObjects()) paths.push_back(item.displayPath);
+    paths.push_back("Device1 / Temperature");
+    paths.push_back("Device9 / Missing");
+
+    auto ids = resolver.resolve(paths);
+    ASSERT_EQ(ids.size(), paths.size());
+    EXPECT_EQ(ids[0], "ns=2;i=1");
+    EXPECT_EQ(ids[10], "ns=2;i=1");
+    EXPECT_TRUE(ids[11].empty());
+    EXPECT_EQ(ua.translateCalls, 3u);
+    EXPECT_EQ(ua.largestBatch, 4u);
+    EXPECT_EQ(resolver.cacheSize(), 10u);
+
+    resolver.resolve(paths);
+    EXPECT_EQ(ua.translateCalls, 4u);  // only the unresolved path is retried
+
+    // The model is checked once per session, not on every resolve.
+    EXPECT_EQ(ua.fingerprintCalls, 1u);
+    ua.fingerprint = "model-2";
+    resolver.resolve(std::string("Device2 / Speed"));
+    EXPECT_EQ(resolver.cacheSize(), 10u);
+    EXPECT_EQ(ua.fingerprintCalls, 1u);
+
+    resolver.setClient(&ua);  // reconnect
+    resolver.resolve(std::string("Device2 / Speed"));
+    EXPECT_EQ(resolver.cacheSize(), 1u);
+    EXPECT_EQ(ua.fingerprintCalls, 2u);
+}
+
+TEST(PathResolverTest, BrowsesOnceWithoutTranslateService)
+{
+    CountingUaClient ua;
+    ua.translateService = false;
+    ua.connect("opc.tcp://localhost:4840");
+    PathResolver resolver(&ua, 2);
+
+    std::vector<std::string> paths;
+    for (const auto& item : ua.browseObjects()) paths.push_back(item.displayPath);
+    ua.browseCalls = 0;
+
+    auto ids = resolver.resolve(paths);
+    EXPECT_EQ(ids.front(), "ns=2;i=1");
+    EXPECT_EQ(ua.browseCalls, 1u);
+    EXPECT_EQ(ua.translateCalls, 0u);
+    EXPECT_EQ(resolver.stats().requests, 1u);
+}
+
+TEST(PathResolverTest, RechecksModelAndDistrustsEmptyFingerprint)
+{
+    CountingUaClient ua;
+    ua.connect("opc.tcp://localhost:4840");
+    PathResolver resolver(&ua);
+    resolver.setRecheckInterval(std::chrono::milliseconds(0));
+
+    EXPECT_EQ(resolver.resolve(std::string("Device3 / Power")), "ns=2;i=7");
+    EXPECT_EQ(resolver.cacheSize(), 1u);
+    ua.fingerprint = "model-2";
+    resolver.resolve(std::string("Device2 / Speed"));
+    EXPECT_EQ(ua.fingerprintCalls, 2u);
+    EXPECT_EQ(resolver.cacheSize(), 1u);  // the model changed: old entry dropped
+
+    // An unknown model keeps no cache across checks and is never persisted.
+    ua.fingerprint.clear();
+    resolver.resolve(std::string("Device2 / Speed"));
+    EXPECT_EQ(resolver.cacheSize(), 1u);
+    const std::size_t calls = ua.translateCalls;
+    resolver.resolve(std::string("Device2 / Speed"));
+    EXPECT_EQ(ua.translateCalls, calls + 1);
+    EXPECT_FALSE(resolver.saveCache("path_cache_unknown.txt"));
+}
+
+TEST(PathResolverTest, GateSeesEveryServerRequest)
+{
+    CountingUaClient ua;
+    ua.connect("opc.tcp://localhost:4840");
+    PathResolver resolver(&ua, 4);
+
+    std::vector<std::string> paths;
+    for (const auto& item : ua.browseObjects()) paths.push_back(item.displayPath);
+    std::size_t gated = 0;
+    auto ids = resolver.resolve(paths, [&](const std::function<void()>& request) {
+        ++gated;
+        request();
+        return true;
+    });
+    EXPECT_EQ(ids.front(), "ns=2;i=1");
+    // isConnected, the fingerprint and three translate batches.
+    EXPECT_EQ(gated, 2 + ua.translateCalls);
+    EXPECT_EQ(ua.translateCalls, 3u);
+
+    resolver.invalidate();
+    ids = resolver.resolve(paths, [](const std::function<void()>&) { return false; });
+    EXPECT_TRUE(ids.front().empty());
+}
+
+TEST(PathResolverTest, PersistentCacheSkipsServerRoundTrips)
+{
+    const std::string file = "path_cache_test.txt";
+    {
+        CountingUaClient ua;
+        ua.connect("opc.tcp://localhost:4840");
+        PathResolver resolver(&ua);
+        EXPECT_EQ(resolver.resolve(std::string("Device3 / Power")), "ns=2;i=7");
+        ASSERT_TRUE(resolver.saveCache(file));
+    }
+
+    CountingUaClient ua;
+    ua.connect("opc.tcp://localhost:4840");
+    PathResolver resolver(&ua);
+    ASSERT_TRUE(resolver.loadCache(file));
+    EXPECT_EQ(resolver.resolve(std::string("Device3 / Power")), "ns=2;i=7");
+    EXPECT_EQ(ua.translateCalls, 0u);
+
+    ua.fingerprint = "restarted";
+    resolver.setClient(&ua);  // reconnect
+    EXPECT_EQ(resolver.resolve(std::string("Device3 / Power")), "ns=2;i=7");
+    EXPECT_EQ(ua.translateCalls, 1u);
+
+    std::remove(file.c_str());
+}
+
+TEST(CaptureReplayTest, ReplayReproducesRecordedSession)
+{
+    const std::string file = "capture_test.uacap";
+    std::vector<BrowseItem> recordedItems;
+    {
+        auto writer = std::make_shared<CaptureWriter>();
+        ASSERT_TRUE(writer->open(file));
+        RecordingUaClient rec(std::make_unique<MockUaClient>(), writer);
+        ASSERT_TRUE(rec.connect("opc.tcp://plc:4840"));
+        recordedItems = rec.browseObjects();
+        EXPECT_EQ(rec.readValue("ns=2;i=5").value, "10.5");
+        EXPECT_TRUE(rec.writeValue("ns=2;i=5", "42.5"));
+        EXPECT_EQ(rec.readValue("ns=2;i=5").value, "42.5");
+        rec.disconnect();
+    }
+
+    std::vector<CaptureRecord> records;
+    ASSERT_TRUE(readCaptureLog(file, records));
+    ASSERT_EQ(records.size(), 6u);
+    EXPECT_EQ(records[2].op, CaptureOp::Read);
+    EXPECT_LE(records[1].startUs, records[2].startUs);
+
+    OpcUaClient client;
+    ASSERT_TRUE(client.open_replay(file));
+    EXPECT_TRUE(client.isConnected());
+
+    auto items = client.browse_objects();
+    ASSERT_EQ(items.size(), recordedItems.size());
+    EXPECT_EQ(items.back().displayPath, recordedItems.back().displayPath);
+
+    EXPECT_EQ(client.read_value("ns=2;i=5").value, "10.5");
+    EXPECT_TRUE(client.write_value("ns=2;i=5", "42.5"));
+    EXPECT_EQ(client.read_value("ns=2;i=5").value, "42.5");
+    EXPECT_EQ(client.read_value("ns=2;i=5").value, "42.5");
+    EXPECT_EQ(client.read_value("ns=2;i=404").value, "<error>");
+
+    std::remove(file.c_str());
+}
+
+TEST(CaptureReplayTest, BatchedReadRecordsEachNode)
+{
+    const std::string file = "capture_batch_test.uacap";
+    const std::vector<std::string> ids{"ns=2;i=1", "ns=2;i=5", "ns=2;i=404"};
+    std::vector<ReadResult> recorded;
+    {
+        auto writer = std::make_shared<CaptureWriter>();
+        ASSERT_TRUE(writer->open(file));
+        RecordingUaClient rec(std::make_unique<MockUaClient>(), writer);
+        ASSERT_TRUE(rec.connect("opc.tcp://plc:4840"));
+        recorded = rec.readValues(ids);
+        ASSERT_EQ(recorded.size(), ids.size());
+        EXPECT_EQ(recorded[1].value, "10.5");
+    }
+
+    std::vector<CaptureRecord> records;
+    ASSERT_TRUE(readCaptureLog(file, records));
+    ASSERT_EQ(records.size(), 1 + ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        EXPECT_EQ(records[1 + i].op, CaptureOp::Read);
+        EXPECT_EQ(records[1 + i].request.front(), ids[i]);
+    }
+
+    OpcUaClient client;
+    ASSERT_TRUE(client.open_replay(file));
+    auto replayed = client.read_values(ids);
+    ASSERT_EQ(replayed.size(), ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) EXPECT_EQ(replayed[i].value, recorded[i].value);
+
+    std::remove(file.c_str());
+}
+
+TEST(CaptureReplayTest, UnwrapEndsRecordingKeepsSession)
+{
+    const std::string file = "capture_release_test.uacap";
+    auto writer = std::make_shared<CaptureWriter>();
+    ASSERT_TRUE(writer->open(file));
+    RecordingUaClient rec(std::make_unique<MockUaClient>(), writer);
+    ASSERT_TRUE(rec.connect("opc.tcp://plc:4840"));
+
+    auto inner = rec.inner();
+    ASSERT_TRUE(inner);
+    EXPECT_TRUE(inner->isConnected());
+    EXPECT_EQ(inner->readValue("ns=2;i=5").value, "10.5");
+    writer->close();
+
+    // The wrapper keeps working after its writer is closed, recording nothing.
+    EXPECT_EQ(rec.readValue("ns=2;i=5").value, "10.5");
+
+    std::vector<CaptureRecord> records;
+    ASSERT_TRUE(readCaptureLog(file, records));
+    EXPECT_EQ(records.size(), 1u);
+
+    std::remove(file.c_str());
+}
+
+TEST(ColumnarExportTest, RowGroupsRoundTrip)
+{
+    const std::string file = "columnar_test.uacol";
+    ColumnarWriter writer(4);
+    ASSERT_TRUE(writer.open(file));
+    for (int i = 0; i < 10; ++i) {
+        ExportRow row;
+        row.path = i % 2 ? "Device1 / Temperature" : "Device1 / Pressure";
+        row.nodeId = "ns=2;i=" + std::to_string(i);
+        row.type = "Double";
+        row.text = std::to_string(i * 0.5);
+        row.value = i * 0.5;
+        row.timestampMs = 1000 + i;
+        row.good = i != 3;
+        ASSERT_TRUE(writer.append(row));
+    }
+    ASSERT_TRUE(writer.close());
+    EXPECT_EQ(writer.rowGroups(), 3u);
+
+    ColumnarReader reader;
+    ASSERT_TRUE(reader.open(file));
+    EXPECT_EQ(reader.rowGroups(), 3u);
+    EXPECT_EQ(reader.totalRows(), 10u);
+
+    std::vector<ExportRow> rows;
+    ASSERT_TRUE(reader.readRowGroup(0, rows));
+    ASSERT_EQ(rows.size(), 4u);
+    EXPECT_EQ(rows[1].path, "Device1 / Temperature");
+    EXPECT_EQ(rows[3].nodeId, "ns=2;i=3");
+    EXPECT_FALSE(rows[3].good);
+    EXPECT_DOUBLE_EQ(rows[2].value, 1.0);
+    ASSERT_TRUE(reader.readRowGroup(2, rows));
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_EQ(rows[1].timestampMs, 1009);
+
+    std::remove(file.c_str());
+}
+
+TEST(ColumnarExportTest, BackgroundExportOfAddressSpace)
+{
+    const std::string file = "export_job_test.uacol";
+    OpcUaClient client;
+    client.connect("opc.tcp://localhost:4840");
+
+    std::atomic<std::uint64_t> reported{0};
+    ExportJob job;
+    ASSERT_TRUE(job.start(client, file, 3,
+                          [&](std::uint64_t done, std::uint64_t) { reported = done; }));
+    // Live reads keep working while the export runs.
+    EXPECT_FALSE(client.read_value("ns=2;i=1").value.empty());
+    job.wait();
+
+    EXPECT_EQ(job.state(), ExportJob::State::Finished);
+    EXPECT_EQ(job.rowsTotal(), 10u);
+    EXPECT_EQ(reported.load(), 10u);
+
+    ColumnarReader reader;
+    ASSERT_TRUE(reader.open(file));
+    EXPECT_EQ(reader.totalRows(), 10u);
+    EXPECT_EQ(reader.rowGroups(), 4u);
+    std::vector<ExportRow> rows;
+    ASSERT_TRUE(reader.readRowGroup(0, rows));
+    EXPECT_EQ(rows[0].path, "Device1 / Temperature");
+    EXPECT_EQ(rows[0].text, "25");
+    EXPECT_TRUE(std::isnan(rows[0].value));  // the mock reports every value as String
+
+    std::remove(file.c_str());
+}
+
+TEST(ValueBusTest, FansOutReadsWithTopicFilters)
+{
+    OpcUaClient client;
+    client.connect("opc.tcp://localhost:4840");
+    ValueBus& bus = client.value_bus();
+
+    auto all = bus.subscribe();
+    TopicFilter only;
+    only.nodeIds.insert("ns=2;i=2");
+    auto filtered = bus.subscribe(only);
+
+    client.read_value("ns=2;i=1");
+    client.read_value("ns=2;i=2");
+
+    EXPECT_EQ(all->pending(), 2u);
+    ValueUpdate u;
+    ASSERT_TRUE(filtered->tryPop(u));
+    EXPECT_EQ(u.nodeId, "ns=2;i=2");
+    EXPECT_EQ(u.text, "1.2");
+    EXPECT_TRUE(u.good);
+    EXPECT_FALSE(filtered->tryPop(u));
+
+    bus.unsubscribe(filtered);
+    client.read_value("ns=2;i=2");
+    EXPECT_EQ(bus.subscriberCount(), 1u);
+    EXPECT_EQ(all->drain([](const ValueUpdate&) {}), 3u);
+}
+
+TEST(ValueBusTest, SlowConsumerPolicies)
+{
+    ValueBus bus;
+    auto dropping = bus.subscribe({}, SlowConsumerPolicy::Drop, 4);
+    std::atomic<std::uint64_t> received{0};
+    {
+        CallbackConsumer slow(bus, [&](const ValueUpdate&) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            ++received;
+        }, {}, SlowConsumerPolicy::Backpressure, 4);
+
+        ValueUpdate u;
+        u.nodeId = "ns=2;i=1";
+        for (int i = 0; i < 200; ++i) {
+            u.value = i;
+            bus.publish(u);
+        }
+        while (received < 200) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        EXPECT_EQ(slow.subscription().dropped(), 0u);
+    }
+
+    EXPECT_EQ(received.load(), 200u);
+    EXPECT_EQ(dropping->delivered(), 4u);
+    EXPECT_EQ(dropping->dropped(), 196u);
+    ValueUpdate first;
+    ASSERT_TRUE(dropping->tryPop(first));
+    EXPECT_EQ(first.value, 0.0);
+}
+
+TEST(ValueBusTest, BlockedConsumerDoesNotStallClientCalls)
+{
+    OpcUaClient client;
+    client.connect("opc.tcp://localhost:4840");
+    auto stuck = client.value_bus().subscribe({}, SlowConsumerPolicy::Backpressure, 2);
+
+    std::thread reader([&] {
+        for (int i = 0; i < 3; ++i) client.read_value("ns=2;i=1");
+    });
+    while (stuck->pending() < 2) std::this_thread::yield();
+
+    // The reader now waits for room; other calls must still get through.
+    EXPECT_TRUE(client.isConnected());
+    EXPECT_TRUE(client.write_value("ns=2;i=5", "1.5"));
+    EXPECT_EQ(client.read_value("ns=2;i=5").value, "1.5");
+
+    // Reads queued behind the stuck publisher are bounded: a bulk reader
+    // waits for room instead of growing the queue without limit.
+    std::atomic<bool> bulkDone{false};
+    std::thread bulk([&] {
+        client.read_values(std::vector<std::string>(3 * ValueBus::kDefaultCapacity, "ns=2;i=1"));
+        bulkDone = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(bulkDone.load());
+
+    client.value_bus().unsubscribe(stuck);
+    reader.join();
+    bulk.join();
+    EXPECT_TRUE(bulkDone.load());
+}
+
+TEST(TrendSeriesTest, LttbKeepsEndpointsAndPeaks)
+{
+    std::vector<TrendPoint> points;
+    for (int i = 0; i < 1000; ++i) points.push_back({i, i == 500 ? 100.0 : 0.0});
+
+    auto out = lttb(points, 50);
+    ASSERT_EQ(out.size(), 50u);
+    EXPECT_EQ(out.front().timestampMs, 0);
+    EXPECT_EQ(out.back().timestampMs, 999);
+    EXPECT_TRUE(std::any_of(out.begin(), out.end(),
+                            [](const TrendPoint& p) { return p.value == 100.0; }));
+}
+
+TEST(TrendSeriesTest, PyramidQueryMatchesRawExtremes)
+{
+    TrendSeries series;
+    const std::int64_t kCount = 2000000;
+    for (std::int64_t i = 0; i < kCount; ++i)
+        series.append(i, std::sin(i * 0.001) + (i == 1234567 ? 50.0 : 0.0));
+    ASSERT_EQ(series.size(), static_cast<size_t>(kCount));
+
+    const std::size_t kPixels = 800;
+    auto all = series.query(0, kCount - 1, kPixels);
+    EXPECT_LE(all.size(), 2 * kPixels);
+    EXPECT_GT(all.size(), kPixels);
+    auto peak = std::max_element(all.begin(), all.end(),
+        [](const TrendPoint& a, const TrendPoint& b) { return a.value < b.value; });
+    EXPECT_EQ(peak->timestampMs, 1234567);
+    EXPECT_TRUE(std::is_sorted(all.begin(), all.end(),
+        [](const TrendPoint& a, const TrendPoint& b) { return a.timestampMs < b.timestampMs; }));
+
+    // A window cut across pyramid buckets must not pull in outside samples.
+    auto window = series.query(1000000, 1234566, kPixels);
+    ASSERT_FALSE(window.empty());
+    for (const auto& p : window) {
+        EXPECT_GE(p.timestampMs, 999999);
+        EXPECT_LE(p.timestampMs, 1234567);
+    }
+    double maxInWindow = -1e9;
+    for (std::int64_t i = 1000000; i <= 1234566; ++i)
+        maxInWindow = std::max(maxInWindow, std::sin(i * 0.001));
+    double maxSeen = -1e9;
+    for (const auto& p : window)
+        if (p.timestampMs <= 1234566) maxSeen = std::max(maxSeen, p.value);
+    EXPECT_DOUBLE_EQ(maxSeen, maxInWindow);
+
+    auto raw = series.query(100, 199, kPixels);
+    EXPECT_EQ(raw.size(), 102u);
+}
+
+TEST(TrendSeriesTest, HistoryFedFromValueBus)
+{
+    OpcUaClient client;
+    client.connect("opc.tcp://localhost:4840");
+
+    TrendHistory history;
+    auto speed = history.series("ns=2;i=4");
+    auto active = history.series("ns=2;i=6");
+    {
+        CallbackConsumer feeder(client.value_bus(),
+                                [&](const ValueUpdate& u) { history.append(u); });
+        for (int i = 0; i < 5; ++i) client.read_value("ns=2;i=4");
+        client.read_value("ns=2;i=6");  // "Active" is not trendable
+        client.read_value("ns=2;i=1");  // not recorded
+    }
+
+    EXPECT_EQ(speed->size(), 5u);
+    EXPECT_EQ(active->size(), 0u);
+    EXPECT_EQ(history.find("ns=2;i=1"), nullptr);
+    EXPECT_EQ(history.nodeIds().size(), 2u);
+}
+
+static ValueUpdate numericUpdate(const std::string& nodeId, double value,
+                                 std::int64_t timestampMs, bool good = true)
+{
+    ValueUpdate u;
+    u.nodeId = nodeId;
+    u.value = value;
+    u.numeric = true;
+    u.good = good;
+    u.timestampMs = timestampMs;
+    u.text = std::to_string(value);
+    return u;
+}
+
+TEST(ValueFilterTest, DeadbandsAndIntervals)
+{
+    ValueFilter filter;
+    FilterConfig abs;
+    abs.absoluteDeadband = 0.5;
+    abs.maxIntervalMs = 10000;
+    filter.configure("abs", abs);
+
+    FilterConfig pct;
+    pct.percentDeadband = 1.0;
+    pct.euLow = 0.0;
+    pct.euHigh = 200.0;
+    pct.minIntervalMs = 100;
+    filter.configure("pct", pct);
+
+    FilterConfig status;
+    status.statusOnly = true;
+    filter.configure("status", status);
+
+    std::vector<ValueUpdate> batch = {
+        numericUpdate("abs", 10.0, 0),      // first value always passes
+        numericUpdate("abs", 10.4, 10),     // inside deadband
+        numericUpdate("abs", 10.6, 20),     // 0.6 from last published
+        numericUpdate("abs", 10.6, 10020),  // heartbeat
+        numericUpdate("pct", 50.0, 0),
+        numericUpdate("pct", 51.5, 50),     // 1.5 < 2 (1% of 200)
+        numericUpdate("pct", 53.0, 60),     // exceeds deadband but within min interval
+        numericUpdate("pct", 53.0, 200),
+        numericUpdate("status", 1.0, 0),
+        numericUpdate("status", 99.0, 10),
+        numericUpdate("status", 99.0, 20, false),
+        numericUpdate("other", 1.0, 0),     // unconfigured: pass-through
+        numericUpdate("other", 1.0, 1),
+    };
+    std::vector<std::uint8_t> pass(batch.size());
+    EXPECT_EQ(filter.filter(batch.data(), batch.size(), pass.data()), 9u);
+    std::vector<std::uint8_t> expected = {1, 0, 1, 1, 1, 0, 0, 1, 1, 0, 1, 1, 1};
+    EXPECT_EQ(pass, expected);
+
+    EXPECT_EQ(filter.stats("abs").received, 4u);
+    EXPECT_EQ(filter.stats("abs").published, 3u);
+    EXPECT_NEAR(filter.stats().suppressionRatio(), 4.0 / 13.0, 1e-9);
+}
+
+TEST(ValueFilterTest, SuppressesUnchangedReadsBeforeConsumers)
+{
+    OpcUaClient client;
+    client.connect("opc.tcp://localhost:4840");
+    client.value_filter().setDefault(FilterConfig{});
+    auto sub = client.value_bus().subscribe();
+
+    for (int i = 0; i < 10; ++i)
+        client.read_values({"ns=2;i=1", "ns=2;i=6"});
+    client.write_value("ns=2;i=1", "26");
+    client.read_value("ns=2;i=1");
+
+    EXPECT_EQ(sub->pending(), 3u);
+    auto stats = client.value_filter().stats();
+    EXPECT_EQ(stats.received, 21u);
+    EXPECT_EQ(stats.published, 3u);
+}
+
+TEST(ValueFilterTest, ChunkedReadsPublishInReadOrder)
+{
+    OpcUaClient client;
+    client.connect("opc.tcp://localhost:4840");
+    auto sub = client.value_bus().subscribe();
+
+    std::vector<std::string> ids;
+    for (std::size_t i = 0; i < 2 * OpcUaClient::kReadChunk + 5; ++i)
+        ids.push_back("ns=2;i=" + std::to_string(1 + i % 10));
+    auto results = client.read_values(ids);
+    ASSERT_EQ(results.size(), ids.size());
+    EXPECT_EQ(results[10].value, client.read_value("ns=2;i=1").value);
+
+    ASSERT_EQ(sub->pending(), ids.size() + 1);
+    ValueUpdate u;
+    for (const auto& id : ids) {
+        ASSERT_TRUE(sub->tryPop(u));
+        EXPECT_EQ(u.nodeId, id);
+    }
+    EXPECT_EQ(client.value_filter().stats().received, ids.size() + 1);
+}
+
+TEST(ValueFilterTest, PassThroughTagsKeepNoState)
+{
+    ValueFilter filter;
+    for (int i = 0; i < 3; ++i) {
+        ValueUpdate u;
+        u.nodeId = "ns=2;i=" + std::to_string(i);
+        u.numeric = true;
+        u.good = true;
+        EXPECT_TRUE(filter.accept(u));
+    }
+    EXPECT_EQ(filter.stats().received, 3u);
+    EXPECT_EQ(filter.stats().published, 3u);
+    EXPECT_EQ(filter.stats("ns=2;i=0").received, 0u);
+}
+
+TEST(ValueFilterTest, SnapshotReadsBypassFilterAndBus)
+{
+    OpcUaClient client;
+    client.connect("opc.tcp://localhost:4840");
+    FilterConfig config;
+    config.minIntervalMs = 60 * 60 * 1000;
+    client.value_filter().configure("ns=2;i=5", config);
+    auto sub = client.value_bus().subscribe();
+
+    client.read_value("ns=2;i=5");
+    auto snapshot = client.snapshot_values({"ns=2;i=5", "ns=2;i=1"});
+    ASSERT_EQ(snapshot.size(), 2u);
+    EXPECT_EQ(snapshot[0].value, "10.5");
+
+    EXPECT_EQ(sub->pending(), 1u);
+    EXPECT_EQ(client.value_filter().stats("ns=2;i=5").received, 1u);
+    EXPECT_EQ(client.value_filter().stats().received, 1u);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);